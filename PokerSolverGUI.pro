@@ -26,22 +26,63 @@ QMAKE_LINK = $$[QT_INSTALL_PREFIX]/../../Tools/mingw1310_64/bin/g++.exe
 
 # Core solver files
 SOURCES += \
+    src/AllInAnalyzer.cpp \
+    src/AllocationCounter.cpp \
+    src/Arena.cpp \
     src/Card.cpp \
+    src/CardAbstraction.cpp \
     src/Deck.cpp \
+    src/FlopReport.cpp \
+    src/HandClass.cpp \
     src/HandEvaluator.cpp \
+    src/HandHistoryImporter.cpp \
+    src/HandLog.cpp \
+    src/HandRecord.cpp \
+    src/LiveSolver.cpp \
+    src/ICMCalculator.cpp \
+    src/MappedFile.cpp \
+    src/MatchRunner.cpp \
     src/Player.cpp \
+    src/PlayerStats.cpp \
     src/PotManager.cpp \
     src/PokerGame.cpp \
-    src/PokerSolver.cpp
+    src/PokerAgents.cpp \
+    src/PokerSolver.cpp \
+    src/PushFoldSolver.cpp \
+    src/RangeHeatmap.cpp \
+    src/SolverStats.cpp \
+    src/TableBatch.cpp \
+    src/Trace.cpp
 
 HEADERS += \
+    include/AllInAnalyzer.h \
+    include/AllocationCounter.h \
+    include/Arena.h \
+    include/BinaryIO.h \
     include/Card.h \
+    include/CardAbstraction.h \
     include/Deck.h \
+    include/FlopReport.h \
+    include/HandClass.h \
     include/HandEvaluator.h \
+    include/HandHistoryImporter.h \
+    include/HandLog.h \
+    include/HandRecord.h \
+    include/LiveSolver.h \
+    include/ICMCalculator.h \
+    include/MappedFile.h \
+    include/MatchRunner.h \
     include/Player.h \
+    include/PlayerStats.h \
     include/PotManager.h \
     include/PokerGame.h \
-    include/PokerSolver.h
+    include/PokerAgents.h \
+    include/PokerSolver.h \
+    include/PushFoldSolver.h \
+    include/RangeHeatmap.h \
+    include/SolverStats.h \
+    include/TableBatch.h \
+    include/Trace.h
 
 # GUI files
 SOURCES += \
@@ -4,6 +4,13 @@
 #include "MainWindow.h"
 #include <QApplication>
 #include <QScreen>
+#include <QFileDialog>
+#include <QStatusBar>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <thread>
+#include "../include/HandClass.h"
 #include <set>
 #include <string>
 
@@ -75,6 +82,76 @@ void CardWidget::paintEvent(QPaintEvent*) {
     }
 }
 
+// ==================== HeatmapWidget Implementation ====================
+
+HeatmapWidget::HeatmapWidget(QWidget* parent)
+    : QWidget(parent), hasGrid(false), highlight(-1) {
+    setMinimumSize(520, 520);
+}
+
+void HeatmapWidget::setGrid(const HeatmapGrid& newGrid) {
+    grid = newGrid;
+    hasGrid = true;
+    update();
+}
+
+void HeatmapWidget::setHighlight(int classIndex) {
+    if (highlight != classIndex) {
+        highlight = classIndex;
+        update();
+    }
+}
+
+void HeatmapWidget::clear() {
+    hasGrid = false;
+    update();
+}
+
+QColor HeatmapWidget::equityColor(double equity) {
+    // Red (0%) through yellow (50%) to green (100%)
+    return QColor::fromHsvF(std::clamp(equity, 0.0, 1.0) / 3.0, 0.75, 0.95);
+}
+
+void HeatmapWidget::paintEvent(QPaintEvent*) {
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    
+    const int cellSize = std::min(width(), height()) / 13;
+    QFont nameFont("Arial", std::max(6, cellSize / 5), QFont::Bold);
+    QFont equityFont("Arial", std::max(5, cellSize / 6));
+    
+    for (int index = 0; index < HandClass::COUNT; index++) {
+        QRect cellRect((index % 13) * cellSize, (index / 13) * cellSize, cellSize - 1, cellSize - 1);
+        const HeatmapCell& cell = grid.cells[index];
+        const bool known = hasGrid && cell.possible && cell.samples > 0;
+        
+        // Cells still converging are drawn faded
+        QColor color = known ? equityColor(cell.equity) : QColor(225, 225, 230);
+        if (known && !cell.converged) {
+            color.setAlpha(110);
+        }
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(color);
+        painter.drawRect(cellRect);
+        
+        if (index == highlight) {
+            painter.setBrush(Qt::NoBrush);
+            painter.setPen(QPen(QColor(26, 26, 46), 3));
+            painter.drawRect(cellRect.adjusted(1, 1, -1, -1));
+        }
+        
+        painter.setPen(QColor(30, 30, 30));
+        painter.setFont(nameFont);
+        painter.drawText(cellRect.adjusted(0, 2, 0, -cellSize / 2), Qt::AlignCenter,
+                         QString::fromStdString(HandClass::fromIndex(index).toString()));
+        if (known) {
+            painter.setFont(equityFont);
+            painter.drawText(cellRect.adjusted(0, cellSize / 2, 0, -2), Qt::AlignCenter,
+                             QString::number(cell.equity * 100.0, 'f', 1));
+        }
+    }
+}
+
 // ==================== MainWindow Implementation ====================
 
 const QStringList MainWindow::RANKS = {
@@ -86,9 +163,17 @@ const QStringList MainWindow::SUITS = {
 };
 
 MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), solver(new PokerSolver(10000))
+    : QMainWindow(parent), liveGeneration(0), displayedGeneration(0),
+      speculationGeneration(0), heatmapGeneration(0)
 {
-    calculationWatcher = new QFutureWatcher<DecisionResult>(this);
+    recomputeTimer = new QTimer(this);
+    recomputeTimer->setSingleShot(true);
+    recomputeTimer->setInterval(150);
+    speculationTimer = new QTimer(this);
+    speculationTimer->setSingleShot(true);
+    speculationTimer->setInterval(500);
+    statsTimer = new QTimer(this);
+    statsTimer->setInterval(1000);
     
     setupUI();
     setupConnections();
@@ -105,10 +190,17 @@ MainWindow::MainWindow(QWidget *parent)
         int y = (screenGeometry.height() - height()) / 2;
         move(x, y);
     }
+    
+    // Preflop heatmap from the start
+    scheduleRecompute();
 }
 
 MainWindow::~MainWindow() {
-    delete solver;
+    // Stop the running computation before the solver goes away
+    liveSolver.supersede();
+    rangeHeatmap.supersede();
+    // Superseded jobs whose futures were overwritten may still be finishing a chunk or round
+    QThreadPool::globalInstance()->waitForDone();
 }
 
 void MainWindow::setupUI() {
@@ -325,12 +417,21 @@ void MainWindow::setupUI() {
     paramsLayout->addWidget(simsIcon, 1, 3);
     paramsLayout->addWidget(new QLabel("Simulations:"), 1, 4);
     numSimulationsInput = new QSpinBox();
-    numSimulationsInput->setRange(1000, 100000);
+    numSimulationsInput->setRange(1000, 1000000);
     numSimulationsInput->setValue(10000);
     numSimulationsInput->setSingleStep(1000);
     numSimulationsInput->setMinimumWidth(150);
     paramsLayout->addWidget(numSimulationsInput, 1, 5);
     
+    // Solver statistics (instrumentation costs nothing while unticked)
+    statsCheckBox = new QCheckBox("Solver statistics");
+    statsCheckBox->setToolTip("Time per phase, trials, evaluations, cache hit rate and thread utilization");
+    paramsLayout->addWidget(statsCheckBox, 2, 1, 1, 2);
+    
+    traceCheckBox = new QCheckBox("Record trace");
+    traceCheckBox->setToolTip("Record a timeline of the computations, saved as Chrome trace JSON when unticked");
+    paramsLayout->addWidget(traceCheckBox, 2, 4, 1, 2);
+    
     paramsGroup->setLayout(paramsLayout);
     mainLayout->addWidget(paramsGroup);
     
@@ -528,6 +629,31 @@ void MainWindow::setupUI() {
     resultsGroup->setLayout(resultsLayout);
     mainLayout->addWidget(resultsGroup);
     
+    // === Range Heatmap Section ===
+    QGroupBox* heatmapGroup = new QGroupBox("🟩 Range Heatmap (equity of every starting hand)", this);
+    heatmapGroup->setStyleSheet("QGroupBox { font-size: 16px; font-weight: bold; color: #16213e; }");
+    QVBoxLayout* heatmapLayout = new QVBoxLayout();
+    
+    heatmapWidget = new HeatmapWidget();
+    heatmapLayout->addWidget(heatmapWidget, 0, Qt::AlignCenter);
+    
+    heatmapStatus = new QLabel("Select board cards and opponents: the grid fills in as cells converge");
+    heatmapStatus->setAlignment(Qt::AlignCenter);
+    heatmapStatus->setStyleSheet("font-size: 12px; color: #666;");
+    heatmapLayout->addWidget(heatmapStatus);
+    
+    heatmapGroup->setLayout(heatmapLayout);
+    mainLayout->addWidget(heatmapGroup);
+    
+    statsLabel = new QLabel();
+    statsLabel->setStyleSheet(
+        "font-family: monospace; font-size: 11px; color: #333; padding: 8px; "
+        "background-color: #f4f6fb; border: 1px solid #ddd; border-radius: 6px;"
+    );
+    statsLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    statsLabel->setVisible(false);
+    mainLayout->addWidget(statsLabel);
+    
     // Shortcuts hint at bottom
     shortcutsHint = new QLabel(
         "⌨️ Shortcuts: Ctrl+Enter = Calculate | Ctrl+C = Clear | Ctrl+1-9 = Set Opponents | Esc = Clear Results"
@@ -545,7 +671,20 @@ void MainWindow::setupUI() {
 void MainWindow::setupConnections() {
     connect(calculateButton, &QPushButton::clicked, this, &MainWindow::onCalculateClicked);
     connect(clearButton, &QPushButton::clicked, this, &MainWindow::onClearClicked);
-    connect(calculationWatcher, &QFutureWatcher<DecisionResult>::finished, this, &MainWindow::onCalculationFinished);
+    connect(recomputeTimer, &QTimer::timeout, this, [this]() { startLiveCalculation(false); });
+    connect(speculationTimer, &QTimer::timeout, this, &MainWindow::startSpeculation);
+    connect(statsTimer, &QTimer::timeout, this, &MainWindow::refreshStats);
+    connect(statsCheckBox, &QCheckBox::toggled, this, &MainWindow::onStatsToggled);
+    connect(traceCheckBox, &QCheckBox::toggled, this, &MainWindow::onTraceToggled);
+    
+    // Recompute (debounced) whenever a card or a parameter changes
+    for (const auto& [rankCombo, suitCombo] : getAllCardCombos()) {
+        connect(rankCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::scheduleRecompute);
+        connect(suitCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::scheduleRecompute);
+    }
+    for (QSpinBox* input : {potSizeInput, callAmountInput, numOpponentsInput, numSimulationsInput}) {
+        connect(input, QOverload<int>::of(&QSpinBox::valueChanged), this, &MainWindow::scheduleRecompute);
+    }
     
     // Update card widgets when selection changes
     connect(holeCard1Rank, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::updateCardWidgets);
@@ -671,68 +810,252 @@ bool MainWindow::hasDuplicateCards() {
 }
 
 void MainWindow::onCalculateClicked() {
+    startLiveCalculation(true);
+}
+
+void MainWindow::scheduleRecompute() {
+    // The user is editing: speculation gives the cores back at once, not after the debounce
+    speculationTimer->stop();
+    if (speculationJob.isRunning()) {
+        liveSolver.supersede();
+        statusBar()->clearMessage();
+    }
+    recomputeTimer->start();
+}
+
+void MainWindow::startLiveCalculation(bool interactive) {
+    recomputeTimer->stop();
+    speculationTimer->stop();
+    statusBar()->clearMessage();
+    
+    // The heatmap only needs the board: it runs even without hole cards
+    startHeatmap();
+    
+    // Any running computation is now stale and stops at its next chunk
+    liveGeneration = liveSolver.supersede();
+    const uint64_t requestGeneration = liveGeneration;
+    
+    LiveSpot spot;
     try {
-        // Check for duplicate cards
         if (hasDuplicateCards()) {
-            QMessageBox::warning(this, "Invalid Cards", 
+            throw std::invalid_argument(
                 "You have selected the same card multiple times. Each card can only be used once.");
-            return;
         }
-        
-        // Parse cards
-        std::vector<Card> holeCards = parseHoleCards();
-        std::vector<Card> board = parseBoardCards();
-        
-        // Get parameters
-        int potSize = potSizeInput->value();
-        int callAmount = callAmountInput->value();
-        int opponents = numOpponentsInput->value();
-        int simulations = numSimulationsInput->value();
-        
-        // Update solver
-        delete solver;
-        solver = new PokerSolver(simulations);
-        
-        // Show progress and disable button
-        progressBar->setVisible(true);
-        progressBar->setRange(0, 0); // Indeterminate
-        calculateButton->setEnabled(false);
-        calculateButton->setText("⏳ Calculating...");
-        
-        // Launch async calculation
-        QFuture<DecisionResult> future = QtConcurrent::run([=]() {
-            return solver->analyzeDecision(holeCards, board, potSize, callAmount, opponents, simulations);
-        });
-        
-        calculationWatcher->setFuture(future);
-        
+        spot.holeCards = parseHoleCards();
+        spot.board = parseBoardCards();
+        heatmapWidget->setHighlight(HandClass::fromCards(spot.holeCards[0], spot.holeCards[1]).index());
     } catch (const std::exception& e) {
+        // Incomplete input while editing is expected: only an explicit Calculate reports it
+        heatmapWidget->setHighlight(-1);
         progressBar->setVisible(false);
-        calculateButton->setEnabled(true);
-        calculateButton->setText("🎲 Calculate Equity");
-        QMessageBox::warning(this, "Error", QString::fromStdString(e.what()));
+        resetCalculateButton();
+        if (interactive) {
+            QMessageBox::warning(this, "Invalid Cards", QString::fromStdString(e.what()));
+        }
+        return;
     }
+    spot.potSize = potSizeInput->value();
+    spot.callAmount = callAmountInput->value();
+    spot.numOpponents = numOpponentsInput->value();
+    spot.simulations = numSimulationsInput->value();
+    lastSpot = spot;
+    
+    // Spot seen before: show it right away, simulate only what is missing
+    LiveUpdate cachedUpdate;
+    if (liveSolver.cached(spot, cachedUpdate)) {
+        cachedUpdate.generation = requestGeneration;
+        onLiveUpdate(cachedUpdate);
+        if (cachedUpdate.final) {
+            return;
+        }
+    }
+    
+    progressBar->setVisible(true);
+    progressBar->setRange(0, spot.simulations);
+    progressBar->setValue(cachedUpdate.simulationsDone);
+    progressBar->setFormat("%v / %m simulations");
+    calculateButton->setText("⏳ Refining...");
+    
+    liveJob = QtConcurrent::run([this, spot, requestGeneration]() {
+        try {
+            return liveSolver.solve(spot, requestGeneration, [this](const LiveUpdate& update) {
+                QMetaObject::invokeMethod(this, [this, update]() { onLiveUpdate(update); }, Qt::QueuedConnection);
+            });
+        } catch (const std::exception&) {
+            return false;
+        }
+    });
 }
 
-void MainWindow::onCalculationFinished() {
-    try {
-        DecisionResult result = calculationWatcher->result();
-        
-        // Display results
-        displayResults(result);
-        
+void MainWindow::onLiveUpdate(const LiveUpdate& update) {
+    // Updates of a superseded request may still be queued
+    if (update.generation != liveGeneration) {
+        return;
+    }
+    
+    // Animate the first result of a request only, not its refinements
+    displayResults(update.result, displayedGeneration != update.generation);
+    displayedGeneration = update.generation;
+    equityLabel->setText(QString("Win Equity: %1% (%2 simulations)")
+        .arg(update.result.equity, 0, 'f', 2)
+        .arg(update.simulationsDone));
+    
+    if (update.final) {
         progressBar->setVisible(false);
-        calculateButton->setEnabled(true);
-        calculateButton->setText("🎲 Calculate Equity");
-        
+        resetCalculateButton();
+        speculationTimer->start();
+    } else {
+        progressBar->setValue(update.simulationsDone);
+    }
+}
+
+void MainWindow::startSpeculation() {
+    // Flop or turn only: the river has no next card, preflop has too many boards
+    if (lastSpot.board.size() < 3 || lastSpot.board.size() >= 5) {
+        return;
+    }
+    
+    // The live result is final, so nothing else runs on this generation
+    speculationGeneration = liveSolver.supersede();
+    const uint64_t requestGeneration = speculationGeneration;
+    const LiveSpot spot = lastSpot;
+    
+    speculationJob = QtConcurrent::run([this, spot, requestGeneration]() {
+        // Idle work: the scheduler runs it only when nothing else wants the core
+        QThread::currentThread()->setPriority(QThread::IdlePriority);
+        bool complete = false;
+        try {
+            complete = liveSolver.speculate(spot, requestGeneration, 2, [this, requestGeneration](int done, int total) {
+                if (done % 16 == 0 || done == total) {
+                    QMetaObject::invokeMethod(this, [this, requestGeneration, done, total]() {
+                        onSpeculationProgress(requestGeneration, done, total);
+                    }, Qt::QueuedConnection);
+                }
+            });
+        } catch (const std::exception&) {
+            complete = false;
+        }
+        // Pool threads are reused by the live and heatmap jobs
+        QThread::currentThread()->setPriority(QThread::NormalPriority);
+        return complete;
+    });
+}
+
+void MainWindow::onSpeculationProgress(uint64_t requestGeneration, int done, int total) {
+    if (requestGeneration != speculationGeneration || !liveSolver.isCurrent(requestGeneration)) {
+        return;
+    }
+    if (done == total) {
+        statusBar()->showMessage(QString("Next cards precomputed (%1 boards)").arg(total), 5000);
+    } else {
+        statusBar()->showMessage(QString("Precomputing next cards: %1 / %2 boards").arg(done).arg(total));
+    }
+}
+
+void MainWindow::startHeatmap() {
+    if (hasDuplicateCards()) {
+        rangeHeatmap.supersede();
+        heatmapSpot.clear();
+        return;
+    }
+    
+    HeatmapConfig config;
+    config.board = parseBoardCards();
+    config.numOpponents = numOpponentsInput->value();
+    // Leave a core to the hole cards computation
+    config.threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    
+    // Pot, call or hole card changes keep the grid (and its running computation)
+    QString spotText;
+    for (const auto& card : config.board) {
+        spotText += QString::fromStdString(card.toString());
+    }
+    spotText += QString("/%1").arg(config.numOpponents);
+    if (spotText == heatmapSpot) {
+        return;
+    }
+    heatmapSpot = spotText;
+    
+    heatmapGeneration = rangeHeatmap.supersede();
+    const uint64_t requestGeneration = heatmapGeneration;
+    
+    // Known board (up to suits): show the cached grid at once
+    HeatmapGrid cachedGrid;
+    if (rangeHeatmap.cached(config, cachedGrid)) {
+        cachedGrid.generation = requestGeneration;
+        onHeatmapUpdate(cachedGrid);
+        if (cachedGrid.final) {
+            return;
+        }
+    } else {
+        heatmapWidget->clear();
+        heatmapStatus->setText("Computing...");
+    }
+    
+    heatmapJob = QtConcurrent::run([this, config, requestGeneration]() {
+        try {
+            return rangeHeatmap.compute(config, requestGeneration, [this](const HeatmapGrid& grid) {
+                QMetaObject::invokeMethod(this, [this, grid]() { onHeatmapUpdate(grid); }, Qt::QueuedConnection);
+            });
+        } catch (const std::exception&) {
+            return false;
+        }
+    });
+}
+
+void MainWindow::onHeatmapUpdate(const HeatmapGrid& grid) {
+    if (grid.generation != heatmapGeneration) {
+        return;
+    }
+    heatmapWidget->setGrid(grid);
+    heatmapStatus->setText(QString("%1 / %2 cells converged - %3 runouts%4")
+        .arg(grid.convergedCells)
+        .arg(grid.possibleCells)
+        .arg(grid.trials)
+        .arg(grid.final ? "" : " (refining...)"));
+}
+
+void MainWindow::onStatsToggled(bool enabled) {
+    // Counting starts from zero each time the box is ticked
+    Instrumentation::setEnabled(enabled);
+    statsLabel->setVisible(enabled);
+    if (enabled) {
+        refreshStats();
+        statsTimer->start();
+    } else {
+        statsTimer->stop();
+    }
+}
+
+void MainWindow::refreshStats() {
+    statsLabel->setText(QString::fromStdString(Instrumentation::stats().toString()).trimmed());
+}
+
+void MainWindow::onTraceToggled(bool enabled) {
+    if (enabled) {
+        Trace::clear();
+        Trace::setEnabled(true);
+        return;
+    }
+    
+    Trace::setEnabled(false);
+    QString path = QFileDialog::getSaveFileName(this, "Save Trace", "trace.json", "Chrome trace (*.json)");
+    if (path.isEmpty()) {
+        return;
+    }
+    try {
+        size_t spans = Trace::writeChromeJson(path.toStdString());
+        statusBar()->showMessage(QString("Trace saved: %1 spans in %2").arg(spans).arg(path), 5000);
     } catch (const std::exception& e) {
-        progressBar->setVisible(false);
-        calculateButton->setEnabled(true);
-        calculateButton->setText("🎲 Calculate Equity");
-        QMessageBox::warning(this, "Error", QString::fromStdString(e.what()));
+        QMessageBox::warning(this, "Trace", QString::fromStdString(e.what()));
     }
 }
 
+void MainWindow::resetCalculateButton() {
+    calculateButton->setEnabled(true);
+    calculateButton->setText("🎲 Calculate Equity");
+}
+
 void MainWindow::onClearClicked() {
     // Reset all inputs
     holeCard1Rank->setCurrentIndex(0);
@@ -793,7 +1116,7 @@ std::vector<Card> MainWindow::parseBoardCards() {
     return board;
 }
 
-void MainWindow::displayResults(const DecisionResult& result) {
+void MainWindow::displayResults(const DecisionResult& result, bool animate) {
     // Update equity
     equityLabel->setText(QString("Win Equity: %1%").arg(result.equity, 0, 'f', 2));
     equityBar->setValue(static_cast<int>(result.equity));
@@ -846,7 +1169,9 @@ void MainWindow::displayResults(const DecisionResult& result) {
     updateVisualIndicators();
     
     // Animate results
-    animateResultsPanel();
+    if (animate) {
+        animateResultsPanel();
+    }
 }
 
 void MainWindow::animateResultsPanel() {
@@ -25,8 +25,14 @@
 #include <QtConcurrent/QtConcurrent>
 #include <QKeyEvent>
 #include <QShortcut>
+#include <QTimer>
+#include <QCheckBox>
 
 #include "../include/PokerSolver.h"
+#include "../include/LiveSolver.h"
+#include "../include/RangeHeatmap.h"
+#include "../include/SolverStats.h"
+#include "../include/Trace.h"
 #include "../include/Card.h"
 
 // Custom Card Widget for beautiful card rendering
@@ -47,6 +53,25 @@ private:
     QColor getSuitColor() const;
 };
 
+// 13x13 grid of starting hand equities on the current board
+class HeatmapWidget : public QWidget {
+    Q_OBJECT
+public:
+    explicit HeatmapWidget(QWidget* parent = nullptr);
+    void setGrid(const HeatmapGrid& newGrid);
+    void setHighlight(int classIndex);
+    void clear();
+    
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    
+private:
+    HeatmapGrid grid;
+    bool hasGrid;
+    int highlight;  // Class of the selected hole cards, -1 if none
+    static QColor equityColor(double equity);
+};
+
 class MainWindow : public QMainWindow {
     Q_OBJECT
 
@@ -60,6 +85,7 @@ private slots:
     void onCard1Changed();
     void onCard2Changed();
     void updateVisualIndicators();
+    void scheduleRecompute();
 
 protected:
     void keyPressEvent(QKeyEvent* event) override;
@@ -75,7 +101,7 @@ private:
     // Helper methods
     std::vector<Card> parseHoleCards();
     std::vector<Card> parseBoardCards();
-    void displayResults(const DecisionResult& result);
+    void displayResults(const DecisionResult& result, bool animate = true);
     void clearResults();
     void updateCardWidgets();
     bool hasDuplicateCards();
@@ -138,12 +164,46 @@ private:
     QLabel* strengthIndicator;
     QLabel* shortcutsHint;
     
-    // Poker Solver
-    PokerSolver* solver;
+    // Poker Solver (one instance for the window's lifetime, cached and cancellable)
+    LiveSolver liveSolver;
+    
+    // Live recalculation: inputs restart the debounce timer, each run supersedes the previous one
+    QTimer* recomputeTimer;
+    QFuture<bool> liveJob;
+    uint64_t liveGeneration;
+    uint64_t displayedGeneration;
+    void startLiveCalculation(bool interactive);
+    void onLiveUpdate(const LiveUpdate& update);
+    void resetCalculateButton();
+    
+    // Speculation: once a result is final and the window idle, the next boards fill the solver cache
+    QTimer* speculationTimer;
+    QFuture<bool> speculationJob;
+    uint64_t speculationGeneration;
+    LiveSpot lastSpot;
+    void startSpeculation();
+    void onSpeculationProgress(uint64_t requestGeneration, int done, int total);
+    
+    // Range heatmap: all 169 classes on the current board, filled in as cells converge
+    HeatmapWidget* heatmapWidget;
+    QLabel* heatmapStatus;
+    RangeHeatmap rangeHeatmap;
+    QFuture<bool> heatmapJob;
+    uint64_t heatmapGeneration;
+    QString heatmapSpot;  // Board and opponents of the grid on screen
+    void startHeatmap();
+    void onHeatmapUpdate(const HeatmapGrid& grid);
+    
+    // Solver statistics: instrumentation on while the box is ticked, refreshed every second
+    QCheckBox* statsCheckBox;
+    QLabel* statsLabel;
+    QTimer* statsTimer;
+    void onStatsToggled(bool enabled);
+    void refreshStats();
     
-    // Async calculation
-    QFutureWatcher<DecisionResult>* calculationWatcher;
-    void onCalculationFinished();
+    // Trace recording: spans are kept while ticked, saved as Chrome trace JSON when unticked
+    QCheckBox* traceCheckBox;
+    void onTraceToggled(bool enabled);
     
     // Constants
     static const QStringList RANKS;
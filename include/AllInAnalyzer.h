@@ -0,0 +1,88 @@
+#ifndef ALL_IN_ANALYZER_H
+#define ALL_IN_ANALYZER_H
+
+#include "HandRecord.h"
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * @brief Configuration of an all-in luck analysis
+ */
+struct AllInConfig {
+    std::string player;          // Screen name to analyze ("" = the hero of each hand)
+    int sessionGapMinutes = 30;  // A longer pause between two hands starts a new session
+    int threads = 0;             // Worker threads (0 = hardware concurrency)
+};
+
+/**
+ * @brief Actual and all-in adjusted results over a set of hands (in big blinds)
+ */
+struct LuckSession {
+    int64_t start = 0;           // Timestamps of the first and last hands
+    int64_t end = 0;
+    long long hands = 0;
+    long long allIns = 0;        // Hands where the player was all-in or called one with cards to come
+    double netBb = 0.0;          // Chips actually won
+    double evNetBb = 0.0;        // Same, with all-in hands scored by their equity
+
+    double luckBb() const { return netBb - evNetBb; }
+};
+
+/**
+ * @brief Sessions and totals of one analysis
+ */
+struct LuckReport {
+    std::string player;
+    LuckSession total;
+    std::vector<LuckSession> sessions;
+    long long equitySpots = 0;   // All-in hands with a pot contested by the player
+    long long computedSpots = 0; // Spots enumerated (the others came from the cache)
+    double seconds = 0.0;
+
+    std::string toString() const;
+
+    /**
+     * @brief One line per session (throws std::runtime_error if the file cannot be written)
+     */
+    void writeCsv(const std::string& path) const;
+};
+
+/**
+ * @brief All-in adjusted EV ("luck") of a player over imported hands
+ *
+ * A hand is an all-in spot when the last chips went in (bet, call, raise
+ * or fold) before the river with at least one live player all-in and
+ * every live player's cards shown. The pots are rebuilt with PotManager
+ * from the chips each seat put in, and the player's expected share of
+ * each pot is its exact equity among the pot's eligible hands, enumerated
+ * over every runout from the board at that moment (the cards of live
+ * players not eligible to a side pot are still out of the deck). Rake is
+ * charged in proportion to the pot, as in the actual result.
+ *
+ * Equities are cached by spot (live hands, board and pot eligibility, with
+ * suits canonicalized), so a repeated matchup is only enumerated once; the
+ * cache lives as long as the analyzer. New spots are enumerated across
+ * worker threads.
+ */
+class AllInAnalyzer {
+private:
+    AllInConfig config;
+    std::unordered_map<std::string, std::vector<double>> cache; // Canonical spot -> share of each hand in each contested pot
+
+public:
+    explicit AllInAnalyzer(const AllInConfig& analysisConfig);
+
+    /**
+     * @brief Analyze a hand record file or a hand log (throws std::runtime_error)
+     * @param progress Optional callback (equities enumerated, equities to enumerate)
+     */
+    LuckReport analyze(const std::string& recordPath,
+                       const std::function<void(long long, long long)>& progress = nullptr);
+
+    size_t getCacheSize() const { return cache.size(); }
+    void clearCache() { cache.clear(); }
+};
+
+#endif // ALL_IN_ANALYZER_H
@@ -0,0 +1,55 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Heap allocations made through operator new, per thread
+ *
+ * Built with POKERSOLVER_COUNT_ALLOCATIONS defined, src/AllocationCounter.cpp
+ * replaces the global operator new and delete with versions that count into
+ * thread-local variables before calling malloc and free: one increment per
+ * allocation, no shared counter. Tests and benchmarks use AllocationScope to
+ * check that a code path does not allocate. The GUI and CLI builds leave the
+ * macro undefined: the standard allocator stays in place and the counters
+ * read zero.
+ *
+ * Not counted: allocations made directly with malloc and the aligned forms
+ * of operator new (std::align_val_t, used for over-aligned types).
+ */
+class AllocationCounter {
+public:
+    /**
+     * @brief Whether src/AllocationCounter.cpp was built with the counting operator new
+     */
+    static bool enabled();
+
+    /**
+     * @brief Allocations made by the calling thread since it started
+     */
+    static uint64_t threadAllocations();
+
+    /**
+     * @brief Bytes requested by those allocations
+     */
+    static uint64_t threadBytes();
+};
+
+/**
+ * @brief Allocations of the calling thread since construction
+ */
+class AllocationScope {
+private:
+    uint64_t startAllocations;
+    uint64_t startBytes;
+
+public:
+    AllocationScope()
+        : startAllocations(AllocationCounter::threadAllocations()), startBytes(AllocationCounter::threadBytes()) {}
+
+    uint64_t allocations() const { return AllocationCounter::threadAllocations() - startAllocations; }
+    uint64_t bytes() const { return AllocationCounter::threadBytes() - startBytes; }
+};
+
+#endif // ALLOCATION_COUNTER_H
@@ -0,0 +1,110 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Bump allocator for the scratch data of a query
+ *
+ * Allocation moves a pointer forward in the current block; nothing is freed
+ * individually. A Scope records the position when a query starts and
+ * rewinds to it when the query ends, releasing all its scratch data at
+ * once. Blocks are kept for the next query, so a warmed-up arena serves
+ * queries without touching the heap. Only trivially destructible types
+ * belong in an arena: no destructor ever runs.
+ *
+ * An arena is used by one thread at a time; forThread() returns the arena
+ * of the calling thread.
+ */
+class Arena {
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    size_t blockSize;
+    std::vector<Block> blocks;
+    size_t current;   // Block being filled
+    size_t used;      // Bytes used in the current block
+
+public:
+    /**
+     * @brief Position to rewind to
+     */
+    struct Mark {
+        size_t block;
+        size_t used;
+    };
+
+    /**
+     * @brief Rewinds an arena to its position at construction
+     */
+    class Scope {
+    private:
+        Arena& arena;
+        Mark mark;
+
+    public:
+        explicit Scope(Arena& scopeArena) : arena(scopeArena), mark(scopeArena.getMark()) {}
+        ~Scope() { arena.rewind(mark); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * @param blockBytes Size of the blocks (larger requests get a block of their own size)
+     */
+    explicit Arena(size_t blockBytes = 64 * 1024);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Uninitialized memory (throws std::bad_alloc if a new block cannot be obtained)
+     * @param alignment Power of two
+     */
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Uninitialized array of count elements
+     */
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena memory is never destroyed");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    Mark getMark() const { return {current, used}; }
+
+    /**
+     * @brief Release everything allocated since the mark (blocks are kept)
+     */
+    void rewind(const Mark& mark);
+
+    /**
+     * @brief Release everything (blocks are kept)
+     */
+    void reset() { rewind({0, 0}); }
+
+    /**
+     * @brief Return the blocks to the heap
+     */
+    void release();
+
+    size_t getBytesUsed() const;
+    size_t getBytesReserved() const;
+    size_t getBlockCount() const { return blocks.size(); }
+
+    /**
+     * @brief Arena of the calling thread, for the scratch data of solver queries
+     */
+    static Arena& forThread();
+};
+
+#endif // ARENA_H
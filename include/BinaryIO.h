@@ -0,0 +1,67 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Byte-level encoding shared by the binary hand formats
+ *
+ * Fixed-width integers are little-endian whatever the platform. Varints
+ * use 7 bits per byte (LEB128); signed values are zigzag-encoded first so
+ * small negative numbers stay short.
+ */
+namespace BinaryIO {
+    const size_t MAX_VARINT_SIZE = 10;
+
+    template <typename T>
+    inline uint8_t* put(uint8_t* out, T value) {
+        uint64_t bits = static_cast<uint64_t>(value);
+        for (size_t i = 0; i < sizeof(T); i++) {
+            out[i] = static_cast<uint8_t>(bits >> (8 * i));
+        }
+        return out + sizeof(T);
+    }
+
+    template <typename T>
+    inline const uint8_t* get(const uint8_t* in, T& value) {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            bits |= static_cast<uint64_t>(in[i]) << (8 * i);
+        }
+        value = static_cast<T>(bits);
+        return in + sizeof(T);
+    }
+
+    inline uint8_t* putVarint(uint8_t* out, uint64_t value) {
+        while (value >= 0x80) {
+            *out++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *out++ = static_cast<uint8_t>(value);
+        return out;
+    }
+
+    /**
+     * @brief Read a varint, nullptr if it runs past end
+     */
+    inline const uint8_t* getVarint(const uint8_t* in, const uint8_t* end, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; in < end && shift < 64; shift += 7) {
+            uint8_t byte = *in++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return in;
+        }
+        return nullptr;
+    }
+
+    inline uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    inline int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+}
+
+#endif // BINARY_IO_H
@@ -63,6 +63,23 @@ public:
      */
     static Card fromString(const std::string& str);
 
+    /**
+     * @brief Dense index of a 2-character card token (same format as fromString), -1 if invalid
+     *
+     * Non-throwing and allocation-free, for bulk parsing.
+     */
+    static int parseIndex(const char* text);
+
+    /**
+     * @brief Dense card index (0-51): suit * 13 + (rank - 2), same order as Deck
+     */
+    int toIndex() const;
+
+    /**
+     * @brief Create a card from its dense index (0-51)
+     */
+    static Card fromIndex(int index);
+
     /**
      * @brief Comparison operator for sorting
      */
@@ -0,0 +1,91 @@
+#ifndef CARD_ABSTRACTION_H
+#define CARD_ABSTRACTION_H
+
+#include "Card.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * @brief Parameters of the equity-distribution abstraction
+ */
+struct AbstractionConfig {
+    int buckets = 50;           // K buckets per board
+    int histogramBins = 50;     // Equity histogram resolution
+    int maxIterations = 100;    // k-means iteration cap
+    int threads = 0;            // Worker threads (0 = hardware concurrency)
+    unsigned int seed = 12345;  // k-means++ seeding
+};
+
+/**
+ * @brief Bucket assignment of every hole-card combo on one board
+ */
+struct BucketMap {
+    static const int NUM_COMBOS = 1326;
+
+    std::vector<Card> board;
+    int numBuckets;
+    std::vector<int16_t> bucketOfCombo; // Indexed by comboIndex(), -1 if blocked by the board
+    double meanDistance;                // Mean EMD of combos to their bucket centroid (quality)
+
+    BucketMap() : numBuckets(0), meanDistance(0.0) {}
+
+    /**
+     * @brief Bucket of a concrete combo (-1 if it conflicts with the board)
+     */
+    int bucketOf(const Card& c1, const Card& c2) const;
+
+    /**
+     * @brief Save to a binary file
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Load from a binary file written by save()
+     */
+    static BucketMap load(const std::string& path);
+
+    /**
+     * @brief Dense index (0-1325) of the combo made of two card indices
+     */
+    static int comboIndex(int card1, int card2);
+};
+
+/**
+ * @brief Card abstraction builder: clusters combos by equity distribution
+ *
+ * For every combo, the builder enumerates all runouts of the board and
+ * records the combo's river hand strength against a uniformly random hand
+ * into a histogram (the EHS distribution). Combos are then clustered into
+ * K buckets with k-means under earth mover's distance, which for 1-D
+ * histograms is the L1 distance between their CDFs. On the river the
+ * histogram is a single spike and the buckets are plain hand-strength bands.
+ */
+class CardAbstraction {
+private:
+    AbstractionConfig config;
+
+public:
+    /**
+     * @brief Constructor
+     * @param cfg Abstraction parameters
+     */
+    explicit CardAbstraction(const AbstractionConfig& cfg = AbstractionConfig());
+
+    /**
+     * @brief Build the bucket map of a flop, turn or river board
+     */
+    BucketMap build(const std::vector<Card>& board) const;
+
+    /**
+     * @brief Equity histograms of all combos (NUM_COMBOS x histogramBins, row-major)
+     *
+     * Rows of combos blocked by the board are all zero.
+     */
+    std::vector<float> equityHistograms(const std::vector<Card>& board) const;
+
+private:
+    int threadCount(int work) const;
+};
+
+#endif // CARD_ABSTRACTION_H
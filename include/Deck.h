@@ -20,6 +20,11 @@ public:
      */
     Deck();
 
+    /**
+     * @brief Reseed the shuffle generator (reproducible deals)
+     */
+    void seed(unsigned int value);
+
     /**
      * @brief Shuffle the deck
      */
@@ -0,0 +1,97 @@
+#ifndef FLOP_REPORT_H
+#define FLOP_REPORT_H
+
+#include "Card.h"
+#include "PokerSolver.h"
+#include <vector>
+#include <string>
+#include <set>
+#include <functional>
+
+/**
+ * @brief Configuration of a batch flop report
+ */
+struct FlopReportConfig {
+    std::string heroHand = "AKs";               // Hero hand class
+    std::string villainHand;                    // Villain hand class (empty = random opponents)
+    int numOpponents = 1;                       // Random opponents when villainHand is empty
+    int simulations = 2000;                     // Monte Carlo trials per flop
+    int threads = 0;                            // Worker threads (0 = hardware concurrency)
+    std::string outputPath = "flop_report.csv"; // Results file (also the progress log)
+};
+
+/**
+ * @brief Summary statistics of one canonical flop
+ */
+struct FlopSummary {
+    std::vector<Card> flop; // Canonical representative
+    int weight;             // Number of raw flops mapping to this one
+    double winRate;
+    double tieRate;
+    double loseRate;
+    int simulations;
+    int combos;             // (hero, villain) combo pairs not blocked by the flop
+
+    std::string toCsvRow() const;
+};
+
+/**
+ * @brief Solves one preflop matchup over every strategically distinct flop
+ *
+ * Both sides are hand classes (or random hands), which are suit-symmetric,
+ * so the 1,755 suit-isomorphic flops cover all 22,100 flops exactly once
+ * each after weighting. The aggregate weights each flop by its raw flops
+ * times the combos it leaves live, so it matches the preflop equity. Flops are scheduled across worker threads and each
+ * finished flop is appended and flushed to the results file, which doubles
+ * as the progress log: rerunning with the same file skips completed flops.
+ * The first line records the matchup and simulation count; a file written
+ * for another configuration is never resumed.
+ */
+class FlopReport {
+private:
+    FlopReportConfig config;
+    PokerSolver solver;
+
+public:
+    /**
+     * @brief Constructor
+     * @param cfg Report configuration
+     */
+    explicit FlopReport(const FlopReportConfig& cfg);
+
+    /**
+     * @brief Canonical form of a board under suit permutations
+     */
+    static std::vector<Card> canonicalBoard(const std::vector<Card>& board);
+
+    /**
+     * @brief All 1,755 canonical flops with their weights
+     */
+    static std::vector<std::pair<std::vector<Card>, int>> canonicalFlops();
+
+    /**
+     * @brief Equity summary of the matchup on one flop
+     */
+    FlopSummary solveFlop(const std::vector<Card>& flop, int weight);
+
+    /**
+     * @brief Solve every flop not already present in the results file
+     *
+     * Throws std::runtime_error if the file holds rows of another matchup or
+     * simulation count, rather than mixing them into one report.
+     * @param progress Optional callback (flops done, total flops)
+     * @return Number of flops solved by this run
+     */
+    int run(const std::function<void(int, int)>& progress = nullptr);
+
+    /**
+     * @brief Aggregate of a results file, weighted by raw flops times live combos
+     */
+    static EquityResult aggregate(const std::string& path);
+
+private:
+    static std::string flopKey(const std::vector<Card>& flop);
+    static std::vector<FlopSummary> loadCompleted(const std::string& path, std::string* matchup = nullptr);
+};
+
+#endif // FLOP_REPORT_H
@@ -0,0 +1,73 @@
+#ifndef HAND_CLASS_H
+#define HAND_CLASS_H
+
+#include "Card.h"
+#include <string>
+#include <vector>
+#include <utility>
+
+/**
+ * @brief One of the 169 strategically distinct starting hands (e.g., "AKs", "QQ", "T9o")
+ *
+ * Classes are laid out on the usual 13x13 grid: row and column 0 are Aces,
+ * pairs sit on the diagonal, suited hands above it and offsuit hands below it.
+ */
+class HandClass {
+private:
+    int highRank;   // 2-14
+    int lowRank;    // 2-14, equal to highRank for pairs
+    bool suited;
+
+public:
+    static const int COUNT = 169;
+
+    /**
+     * @brief Constructor
+     * @param high Higher rank value (2-14)
+     * @param low Lower rank value (2-14)
+     * @param isSuited Suited flag (ignored for pairs)
+     */
+    HandClass(int high, int low, bool isSuited);
+
+    /**
+     * @brief Parse a class from text ("AKs", "AKo", "QQ")
+     */
+    static HandClass fromString(const std::string& str);
+
+    /**
+     * @brief Class of a concrete pair of hole cards
+     */
+    static HandClass fromCards(const Card& c1, const Card& c2);
+
+    /**
+     * @brief Class at a grid index (0-168)
+     */
+    static HandClass fromIndex(int index);
+
+    /**
+     * @brief Grid index (row * 13 + column)
+     */
+    int index() const;
+
+    int getHighRank() const { return highRank; }
+    int getLowRank() const { return lowRank; }
+    bool isPair() const { return highRank == lowRank; }
+    bool isSuited() const { return suited; }
+
+    /**
+     * @brief Number of concrete combos (6 for pairs, 4 suited, 12 offsuit)
+     */
+    int comboCount() const;
+
+    /**
+     * @brief All concrete combos of this class
+     */
+    std::vector<std::pair<Card, Card>> combos() const;
+
+    /**
+     * @brief Text representation (e.g., "AKs")
+     */
+    std::string toString() const;
+};
+
+#endif // HAND_CLASS_H
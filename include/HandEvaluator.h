@@ -4,6 +4,8 @@
 #include "Card.h"
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <initializer_list>
 
 /**
  * @brief Poker hand types (from weakest to strongest)
@@ -26,10 +28,11 @@ enum class HandRank {
  */
 struct HandValue {
     HandRank rank;
-    std::vector<int> kickers; // Pour départager les égalités
+    int kickers[5]; // Pour départager les égalités (numKickers premiers)
+    int numKickers;
     int score; // Score numérique unique pour comparaison rapide
     
-    HandValue() : rank(HandRank::HIGH_CARD), score(0) {}
+    HandValue() : rank(HandRank::HIGH_CARD), kickers{0, 0, 0, 0, 0}, numKickers(0), score(0) {}
     
     bool operator>(const HandValue& other) const {
         return score > other.score;
@@ -53,27 +56,55 @@ class HandEvaluator {
 public:
     /**
      * @brief Evaluates the best 5-card hand from 7 cards
+     *
+     * Not counted by Instrumentation: callers that evaluate in a loop add
+     * their own totals once per query or chunk.
      * @param cards 7 cards (2 hole cards + 5 board cards)
      * @return Hand value
      */
-    static HandValue evaluate(std::vector<Card> cards);
+    static HandValue evaluate(const std::vector<Card>& cards);
 
     /**
      * @brief Evaluates exactly 5 cards
      */
     static HandValue evaluateFiveCards(const std::vector<Card>& cards);
 
+    /**
+     * @brief Score of the best 5-card hand from 5 to 7 cards given as indices (Card::toIndex)
+     *
+     * Allocation-free fast path: returns exactly evaluate(cards).score, from
+     * rank counts and suit bitmasks instead of trying every 5-card subset.
+     */
+    static int evaluateScore(const uint8_t* cardIndices, int count);
+
+    /**
+     * @brief evaluateScore over many hands in one call (counted once per call by Instrumentation)
+     * @param hands Card indices, 7 slots per hand (slots past the count are ignored)
+     * @param counts Number of cards in each hand (5 to 7)
+     * @param numHands Number of hands
+     * @param scores Output, one score per hand
+     */
+    static void evaluateScores(const uint8_t* hands, const uint8_t* counts, int numHands, int* scores);
+
+    /**
+     * @brief Hand rank encoded in a score
+     */
+    static HandRank rankOfScore(int score) { return static_cast<HandRank>(score / 100000000); }
+
     /**
      * @brief Compares two hands and returns 1 if hand1 wins, -1 if hand2 wins, 0 if tie
      */
     static int compareHands(const HandValue& hand1, const HandValue& hand2);
 
 private:
-    static bool isFlush(const std::vector<Card>& cards);
-    static bool isStraight(const std::vector<Card>& cards, int& highCard);
-    static std::vector<int> getRankCounts(const std::vector<Card>& cards);
-    static HandValue evaluateRankCounts(const std::vector<int>& counts, const std::vector<Card>& cards);
-    static int calculateScore(HandRank rank, const std::vector<int>& kickers);
+    /**
+     * @brief Evaluates exactly 5 cards, without allocating
+     */
+    static HandValue evaluateFive(const Card* const* cards);
+    static void setHand(HandValue& hand, HandRank rank, std::initializer_list<int> kickers);
+    static bool isFlush(const Card* const* cards);
+    static bool isStraight(const int* sortedRanks, int& highCard);
+    static int calculateScore(HandRank rank, const int* kickers, int count);
 };
 
 #endif // HAND_EVALUATOR_H
@@ -0,0 +1,72 @@
+#ifndef HAND_HISTORY_IMPORTER_H
+#define HAND_HISTORY_IMPORTER_H
+
+#include "HandRecord.h"
+#include <string>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * @brief Totals of an import
+ */
+struct ImportStats {
+    long long hands = 0;     // Hands written
+    long long skipped = 0;   // Hands not imported (other games, run it twice, malformed)
+    long long bytes = 0;     // Size of the history file
+    double seconds = 0.0;
+
+    double megabytesPerSecond() const {
+        return seconds > 0.0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Imports PokerStars hold'em hand histories into hand record files
+ *
+ * The history file is memory-mapped and cut into segments; each worker
+ * thread parses the hands starting in its segment (a hand belongs to the
+ * segment where its "PokerStars " header line starts) straight from the
+ * mapped text into a reused HandRecord, without per-hand allocations.
+ * Segments are written in file order, so the output does not depend on
+ * the number of threads.
+ */
+class HandHistoryImporter {
+private:
+    int threads;
+    size_t segmentSize;
+
+public:
+    /**
+     * @param numThreads Worker threads (0 = hardware concurrency)
+     * @param segmentBytes Bytes of history handed to a worker at a time
+     */
+    explicit HandHistoryImporter(int numThreads = 0, size_t segmentBytes = 8u << 20);
+
+    /**
+     * @brief Convert a history file (throws std::runtime_error)
+     *
+     * Writes a hand log (HandLogWriter) when outputPath ends in ".phl",
+     * otherwise a hand record file (HandRecordWriter).
+     * @param progress Optional callback (bytes parsed, total bytes)
+     */
+    ImportStats importFile(const std::string& historyPath, const std::string& outputPath,
+                           const std::function<void(long long, long long)>& progress = nullptr) const;
+
+    /**
+     * @brief Parse the text of one hand
+     * @param begin First character of the "PokerStars " header line
+     * @param end End of the hand text
+     * @param record Output (overwritten)
+     * @param names Optional playerId -> screen name table to extend
+     * @return False if the hand is not a supported hold'em hand
+     */
+    static bool parseHand(const char* begin, const char* end, HandRecord& record,
+                          std::unordered_map<uint64_t, std::string>* names = nullptr);
+
+    /**
+     * @brief First hand header at or after from (end if none)
+     */
+    static const char* findHandStart(const char* from, const char* fileBegin, const char* end);
+};
+
+#endif // HAND_HISTORY_IMPORTER_H
@@ -0,0 +1,201 @@
+#ifndef HAND_LOG_H
+#define HAND_LOG_H
+
+#include "HandRecord.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+
+class HandLog;
+
+/**
+ * @brief One hand of a hand log, decoded lazily
+ *
+ * HandLogCursor::next only decodes the header fields below; seats and
+ * actions stay encoded in the cursor's block buffer until asked for, so a
+ * pass that only needs a few fields skips the rest. An entry is valid
+ * until its cursor moves to the next block.
+ */
+struct HandLogEntry {
+    uint64_t handId;
+    uint64_t tournamentId;
+    int64_t timestamp;
+    uint64_t tableId;
+    int32_t smallBlind;
+    int32_t bigBlind;
+    int32_t ante;
+    uint8_t flags;
+    uint8_t numSeats;
+    uint8_t button;
+    uint8_t boardCount;
+    uint8_t numActions;
+    uint8_t board[5];
+
+    /**
+     * @brief Decode the numSeats seats
+     * @param playerIndices Optional output, dense index of each seat's player in the log
+     */
+    void decodeSeats(HistorySeat* seats, uint32_t* playerIndices = nullptr) const;
+
+    /**
+     * @brief Decode the numActions actions
+     */
+    void decodeActions(HistoryAction* actions) const;
+
+    /**
+     * @brief Decode everything
+     */
+    void toRecord(HandRecord& record) const;
+
+private:
+    const HandLog* log = nullptr;
+    const uint8_t* seatData = nullptr;
+    const uint8_t* actionData = nullptr;
+    const uint8_t* end = nullptr;
+
+    friend class HandLogCursor;
+};
+
+/**
+ * @brief Writes hand records to a compact, block-compressed hand log
+ *
+ * Each hand is encoded with 1-byte cards, varint amounts (zigzag for
+ * signed values) and hand ids and timestamps as deltas from the previous
+ * hand of the block; players are stored as indices into a player table
+ * written once at the end of the file. Hands are packed into blocks of
+ * about blockSize bytes, each compressed with a byte-oriented LZ77 codec
+ * (stored raw when that does not help), and an index of the blocks ends
+ * the file so readers can seek or split the work by block.
+ *
+ * write() reuses its buffers and does not allocate once they have grown,
+ * so it keeps up with silent self-play. Not thread-safe: use one writer
+ * per thread.
+ */
+class HandLogWriter {
+private:
+    struct BlockInfo {
+        uint64_t offset;
+        uint32_t storedSize;
+        uint32_t rawSize;
+        uint32_t records;
+        uint32_t compressed;
+    };
+
+    std::ofstream out;
+    size_t blockSize;
+    std::vector<uint8_t> block;
+    size_t used;
+    std::vector<uint8_t> compressed;
+    uint32_t blockRecords;
+    uint64_t previousHandId;
+    int64_t previousTimestamp;
+    uint64_t offset;
+    uint64_t count;
+    std::unordered_map<uint64_t, uint32_t> playerIndex;
+    std::vector<uint64_t> players;
+    std::vector<BlockInfo> blocks;
+
+    void flushBlock();
+
+public:
+    static const uint32_t VERSION = 1;
+
+    /**
+     * @brief Create the file (throws std::runtime_error on failure)
+     */
+    explicit HandLogWriter(const std::string& path, size_t blockBytes = 64 * 1024);
+
+    void write(const HandRecord& record);
+
+    /**
+     * @brief Flush the last block, write the player table, the names and the index
+     */
+    void finish(const std::unordered_map<uint64_t, std::string>& names = {});
+
+    uint64_t getCount() const { return count; }
+    uint64_t getBytesWritten() const { return offset; }
+};
+
+/**
+ * @brief Memory-mapped hand log: block index and player table
+ *
+ * Read-only after construction, so several HandLogCursor can share it
+ * across threads.
+ */
+class HandLog {
+private:
+    struct BlockInfo {
+        uint64_t offset;
+        uint32_t storedSize;
+        uint32_t rawSize;
+        uint32_t records;
+        bool compressed;
+        uint64_t firstRecord;
+    };
+
+    MappedFile file;
+    std::vector<BlockInfo> blocks;
+    std::vector<uint64_t> players;
+    std::unordered_map<uint64_t, std::string> names;
+    uint64_t numRecords;
+
+    friend class HandLogCursor;
+
+public:
+    /**
+     * @brief Open and validate a hand log (throws std::runtime_error)
+     */
+    explicit HandLog(const std::string& path);
+
+    /**
+     * @brief True if the file starts like a hand log
+     */
+    static bool isHandLog(const std::string& path);
+
+    size_t getNumBlocks() const { return blocks.size(); }
+    uint64_t getNumRecords() const { return numRecords; }
+    uint64_t getBlockFirstRecord(size_t block) const { return blocks.at(block).firstRecord; }
+
+    size_t getNumPlayers() const { return players.size(); }
+    uint64_t getPlayerId(uint32_t index) const { return players.at(index); }
+    const std::unordered_map<uint64_t, std::string>& getNames() const { return names; }
+};
+
+/**
+ * @brief Sequential reader over a range of blocks of a HandLog
+ *
+ * Decompresses one block at a time into its own buffer; give each thread
+ * its own cursor over its own blocks.
+ */
+class HandLogCursor {
+private:
+    const HandLog& log;
+    size_t block;
+    size_t endBlock;
+    std::vector<uint8_t> buffer;
+    const uint8_t* position;
+    const uint8_t* blockEnd;
+    uint64_t previousHandId;
+    int64_t previousTimestamp;
+
+    void loadBlock(size_t index);
+
+public:
+    /**
+     * @param handLog Log to read (must outlive the cursor)
+     * @param firstBlock First block to read
+     * @param lastBlock One past the last block (clamped to the number of blocks)
+     */
+    explicit HandLogCursor(const HandLog& handLog, size_t firstBlock = 0, size_t lastBlock = SIZE_MAX);
+
+    /**
+     * @brief Header of the next hand, false after the last block (throws std::runtime_error if corrupt)
+     */
+    bool next(HandLogEntry& entry);
+};
+
+#endif // HAND_LOG_H
@@ -0,0 +1,173 @@
+#ifndef HAND_RECORD_H
+#define HAND_RECORD_H
+
+#include "MappedFile.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <fstream>
+#include <unordered_map>
+
+/**
+ * @brief Kind of a recorded action
+ */
+enum class HistoryActionType : uint8_t {
+    POST_SMALL_BLIND,
+    POST_BIG_BLIND,
+    POST_ANTE,
+    POST_BLIND,     // Other posts (dead blinds, small & big blinds)
+    FOLD,
+    CHECK,
+    CALL,
+    BET,
+    RAISE,
+    UNCALLED        // Uncalled bet returned to the player
+};
+
+/**
+ * @brief One action of a recorded hand
+ *
+ * The amount is the chips the action moved (for a raise, the chips added
+ * on top of what the player already had in on this street, not the total).
+ */
+struct HistoryAction {
+    uint8_t seat;           // Index into HandRecord::seats
+    uint8_t street;         // GamePhase value (PRE_FLOP to RIVER)
+    HistoryActionType type;
+    bool allIn;
+    int32_t amount;
+};
+
+/**
+ * @brief One player dealt into a recorded hand
+ */
+struct HistorySeat {
+    static const uint8_t HERO = 1;    // Hole cards known from "Dealt to"
+    static const uint8_t SHOWED = 2;  // Hole cards shown or mucked at showdown
+    static const uint8_t ALL_IN = 4;
+    static const uint8_t FOLDED = 8;
+
+    uint64_t playerId;      // HandRecord::playerId of the screen name
+    int32_t stack;          // Stack at the start of the hand
+    int32_t invested;       // Chips put in the pot (uncalled bets excluded)
+    int32_t collected;      // Chips won from the pots
+    uint8_t seatNumber;     // Seat number at the table (1-based)
+    uint8_t cards[2];       // Dense card indices (Card::toIndex), NO_CARD when unknown
+    uint8_t flags;
+};
+
+/**
+ * @brief Fixed-capacity binary record of one played hand
+ *
+ * Amounts are in cents for cash games and in chips for tournaments. The
+ * record is a plain struct so parsers can refill the same instance for
+ * every hand; serialize() writes only the seats and actions in use.
+ */
+struct HandRecord {
+    static const int MAX_SEATS = 10;
+    static const int MAX_ACTIONS = 128;
+    static const uint8_t NO_CARD = 0xFF;
+    static const uint8_t TOURNAMENT = 1;
+    static const size_t MAX_SERIALIZED_SIZE = 56 + MAX_SEATS * 24 + MAX_ACTIONS * 8;
+
+    uint64_t handId;
+    uint64_t tournamentId;  // 0 for cash games
+    int64_t timestamp;      // Seconds since 1970 of the time printed in the header
+    uint64_t tableId;       // playerId-style hash of the table name
+    int32_t smallBlind;
+    int32_t bigBlind;
+    int32_t ante;
+    uint8_t flags;
+    uint8_t numSeats;
+    uint8_t button;         // Index into seats, NO_CARD when unknown
+    uint8_t boardCount;
+    uint8_t board[5];
+    uint8_t numActions;
+    HistorySeat seats[MAX_SEATS];
+    HistoryAction actions[MAX_ACTIONS];
+
+    void clear();
+
+    /**
+     * @brief Stable 64-bit id of a name (FNV-1a)
+     */
+    static uint64_t playerId(const char* name, size_t length);
+
+    /**
+     * @brief Write the record (little-endian), returns the bytes written
+     * @param out Buffer of at least MAX_SERIALIZED_SIZE bytes
+     */
+    size_t serialize(uint8_t* out) const;
+
+    /**
+     * @brief Read a record, returns the bytes consumed or 0 if truncated or corrupt
+     */
+    static size_t deserialize(const uint8_t* in, size_t available, HandRecord& record);
+};
+
+/**
+ * @brief Writes a hand record file
+ *
+ * Layout: "PSHH", version, record count and name table offset, then the
+ * serialized records back to back, then the playerId -> name table.
+ */
+class HandRecordWriter {
+private:
+    std::ofstream out;
+    uint64_t count;
+
+public:
+    static const uint32_t VERSION = 1;
+
+    /**
+     * @brief Create the file (throws std::runtime_error on failure)
+     */
+    explicit HandRecordWriter(const std::string& path);
+
+    void write(const HandRecord& record);
+
+    /**
+     * @brief Append already serialized records
+     */
+    void writeSerialized(const uint8_t* data, size_t size, uint64_t records);
+
+    /**
+     * @brief Write the name table and the final header
+     */
+    void finish(const std::unordered_map<uint64_t, std::string>& names);
+
+    uint64_t getCount() const { return count; }
+};
+
+/**
+ * @brief Sequential reader of a memory-mapped hand record file
+ */
+class HandRecordReader {
+private:
+    MappedFile file;
+    const uint8_t* position;
+    const uint8_t* recordsEnd;
+    uint64_t count;
+    std::unordered_map<uint64_t, std::string> names;
+
+public:
+    /**
+     * @brief Open and validate a file (throws std::runtime_error)
+     */
+    explicit HandRecordReader(const std::string& path);
+
+    /**
+     * @brief Read the next record, false at the end of the file
+     */
+    bool next(HandRecord& record);
+
+    /**
+     * @brief Restart from the first record
+     */
+    void rewind();
+
+    uint64_t getCount() const { return count; }
+    const std::unordered_map<uint64_t, std::string>& getNames() const { return names; }
+};
+
+#endif // HAND_RECORD_H
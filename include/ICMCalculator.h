@@ -0,0 +1,68 @@
+#ifndef ICM_CALCULATOR_H
+#define ICM_CALCULATOR_H
+
+#include <vector>
+
+/**
+ * @brief Independent Chip Model: converts tournament stacks into prize equity
+ *
+ * Finishing orders follow Malmuth-Harville: a player finishes first with
+ * probability stack / total chips, and the remaining places are filled the
+ * same way among the remaining players. Final tables are computed exactly
+ * with a dynamic program over bitmasks of already-placed players; larger
+ * fields use Monte Carlo sampling of finishing orders.
+ */
+class ICMCalculator {
+private:
+    std::vector<double> payouts; // payouts[0] = first place
+    int exactLimit;              // Largest field solved exactly
+    int monteCarloTrials;
+
+public:
+    /**
+     * @brief Constructor
+     * @param prizes Prize for each paid place, first place first
+     * @param maxExactPlayers Fields up to this size use the exact DP (max 20)
+     * @param trials Monte Carlo trials for larger fields
+     */
+    explicit ICMCalculator(const std::vector<double>& prizes,
+                           int maxExactPlayers = 16,
+                           int trials = 100000);
+
+    /**
+     * @brief Prize equity of every player (exact or Monte Carlo depending on field size)
+     */
+    std::vector<double> equities(const std::vector<double>& stacks) const;
+
+    /**
+     * @brief Prize equity of every player after a hand in which some may have busted
+     *
+     * Zero stacks listed in inHand busted in this hand: they take the lowest
+     * places still open, just below the players left, and split those prizes
+     * evenly when several bust at once. Other zero stacks were out before the
+     * hand and get nothing, as in equities().
+     * @param stacks Stacks after the hand
+     * @param inHand Indices of the players who played the hand
+     */
+    std::vector<double> equitiesAfterHand(const std::vector<double>& stacks, const std::vector<int>& inHand) const;
+
+    /**
+     * @brief Exact Malmuth-Harville equities (bitmask DP, up to 20 players)
+     */
+    std::vector<double> exactEquities(const std::vector<double>& stacks) const;
+
+    /**
+     * @brief Monte Carlo equities from sampled Harville finishing orders
+     */
+    std::vector<double> monteCarloEquities(const std::vector<double>& stacks,
+                                           int trials, unsigned int seed = 12345) const;
+
+    /**
+     * @brief Prize equity of a single player
+     */
+    double equity(const std::vector<double>& stacks, int player) const;
+
+    const std::vector<double>& getPayouts() const { return payouts; }
+};
+
+#endif // ICM_CALCULATOR_H
@@ -0,0 +1,124 @@
+#ifndef LIVE_SOLVER_H
+#define LIVE_SOLVER_H
+
+#include "PokerSolver.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Spot analyzed by the live solver
+ */
+struct LiveSpot {
+    std::vector<Card> holeCards;
+    std::vector<Card> board;
+    int potSize = 0;
+    int callAmount = 0;
+    int numOpponents = 1;
+    int simulations = 10000;  // Target number of simulations
+};
+
+/**
+ * @brief Intermediate or final result of a live computation
+ */
+struct LiveUpdate {
+    DecisionResult result;
+    int simulationsDone = 0;
+    int simulationsTarget = 0;
+    bool fromCache = false;   // Taken from earlier computations, no new simulation yet
+    bool final = false;       // Target reached
+    uint64_t generation = 0;  // Request this update answers
+};
+
+/**
+ * @brief Long-lived solver for interactive use: cached, progressive, cancellable
+ *
+ * Every new request takes a new generation number, which supersedes the
+ * computations of older generations: they stop at their next chunk
+ * boundary. A computation first reports what the cache already knows about
+ * the spot, then runs the simulations still missing in chunks (small first,
+ * doubling up to a cap that bounds the cancellation latency), reporting
+ * the refined result after each chunk.
+ *
+ * Simulation counts are cached by cards and number of opponents (pot and
+ * call amounts do not change the equity), and chunks of a superseded
+ * computation are still added to the cache, so going back to a spot
+ * resumes where it was left. The cache and generation are thread-safe; one
+ * PokerSolver instance serves every request. speculate() fills the same
+ * cache ahead of the user, for the turn and river cards that may come next.
+ */
+class LiveSolver {
+private:
+    struct Tally {
+        long long wins = 0;
+        long long ties = 0;
+        long long losses = 0;
+
+        long long total() const { return wins + ties + losses; }
+    };
+
+    PokerSolver solver;
+    int firstChunk;
+    int maxChunk;
+    size_t maxCacheEntries;
+    std::atomic<uint64_t> generation;
+    mutable std::mutex cacheMutex;
+    std::unordered_map<std::string, Tally> cache;
+
+    static std::string spotKey(const LiveSpot& spot);
+    Tally lookup(const std::string& key) const;
+    Tally add(const std::string& key, const Tally& tally);
+    LiveUpdate makeUpdate(const LiveSpot& spot, const Tally& tally, uint64_t requestGeneration) const;
+
+public:
+    /**
+     * @param firstChunkSize Simulations of the first (fast estimate) chunk
+     * @param maxChunkSize Largest chunk between two cancellation checks
+     * @param cacheEntries Spots kept before the cache is emptied
+     */
+    explicit LiveSolver(int firstChunkSize = 500, int maxChunkSize = 4000, size_t cacheEntries = 32768);
+
+    /**
+     * @brief Start a new generation, superseding every running computation
+     */
+    uint64_t supersede();
+
+    bool isCurrent(uint64_t requestGeneration) const { return generation.load() == requestGeneration; }
+
+    /**
+     * @brief Cached result of a spot, without simulating (false if never computed)
+     */
+    bool cached(const LiveSpot& spot, LiveUpdate& update) const;
+
+    /**
+     * @brief Compute a spot progressively (throws std::invalid_argument on bad cards)
+     * @param requestGeneration Value returned by supersede() for this request
+     * @param onUpdate Called from the computing thread after each step
+     * @return False if superseded before reaching the target
+     */
+    bool solve(const LiveSpot& spot, uint64_t requestGeneration,
+               const std::function<void(const LiveUpdate&)>& onUpdate);
+
+    /**
+     * @brief Fill the cache for the boards that can follow a spot (throws std::invalid_argument on bad cards)
+     *
+     * Runs spot.simulations for every board with one more card, then for
+     * every board with two more cards, skipping boards already in the cache.
+     * Meant for idle time: any request taking a new generation preempts it.
+     * Only flops and turns are expanded.
+     * @param streets Cards ahead to precompute (1 = next street, 2 = the two next)
+     * @param onProgress Optional callback (boards done, boards total)
+     * @return False if superseded before every board was computed
+     */
+    bool speculate(const LiveSpot& spot, uint64_t requestGeneration, int streets = 2,
+                   const std::function<void(int, int)>& onProgress = nullptr);
+
+    size_t getCacheSize() const;
+    void clearCache();
+};
+
+#endif // LIVE_SOLVER_H
@@ -0,0 +1,40 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Uses mmap on POSIX systems and a file mapping on Windows. The contents
+ * stay mapped for the lifetime of the object; empty files give a null
+ * data pointer and a size of 0.
+ */
+class MappedFile {
+private:
+    const char* mapped;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fd;
+#endif
+
+public:
+    /**
+     * @brief Map a file (throws std::runtime_error on failure)
+     */
+    explicit MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return mapped; }
+    size_t size() const { return length; }
+};
+
+#endif // MAPPED_FILE_H
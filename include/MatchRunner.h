@@ -0,0 +1,96 @@
+#ifndef MATCH_RUNNER_H
+#define MATCH_RUNNER_H
+
+#include "PokerGame.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+
+/**
+ * @brief Creates one agent instance per worker thread (seeded differently)
+ */
+typedef std::function<std::unique_ptr<PokerAgent>(unsigned int seed)> AgentFactory;
+
+/**
+ * @brief Configuration of a bot-versus-bot match
+ */
+struct MatchConfig {
+    long long deals = 10000;  // Distinct card deals (each is replayed once per seat rotation in duplicate mode)
+    int smallBlind = 5;
+    int bigBlind = 10;
+    int stack = 1000;         // Every player starts every hand with this stack
+    bool duplicate = true;    // Replay each deal with the agents rotated through every seat
+    bool allInAdjust = true;  // Score all-ins by their equity instead of the actual runout
+    int allInRunouts = 2000;  // Runouts sampled when exact enumeration would need more
+    int threads = 0;          // Worker threads (0 = hardware concurrency)
+    unsigned int seed = 12345;
+    long long reportEvery = 1000; // Deals between progress callbacks
+};
+
+/**
+ * @brief Results of one agent
+ */
+struct AgentMatchStats {
+    std::string name;
+    long long hands = 0;
+    double bbPer100 = 0.0;          // Actual chips won
+    double bbPer100Ci = 0.0;        // 95% confidence half-width
+    double adjustedBbPer100 = 0.0;  // All-in EV adjusted
+    double adjustedBbPer100Ci = 0.0;
+    long long allIns = 0;           // Hands that ended in an all-in with cards to come
+};
+
+/**
+ * @brief Match summary (also the progress snapshot)
+ */
+struct MatchResult {
+    long long deals = 0;
+    long long hands = 0;
+    int numPlayers = 0;
+    bool duplicate = false;
+    double seconds = 0.0;
+    std::vector<AgentMatchStats> agents;
+
+    std::string toString() const;
+    std::string toJson() const;
+};
+
+/**
+ * @brief Plays agents against each other across all cores
+ *
+ * Every deal is a seeded PokerGame hand with stacks reset to the starting
+ * stack; the button stays on seat 0 and the agents move around it. In
+ * duplicate mode the same cards are replayed once per cyclic
+ * rotation of the agents around the table, so every agent holds every
+ * seat's cards and card luck cancels out within the group; confidence
+ * intervals are computed over these groups. With all-in adjustment, a hand
+ * where the betting closes with two or more players all-in and cards to
+ * come is scored by each player's expected share of every side pot over
+ * all runouts (PotManager::allInExpectedWinnings), removing runout luck.
+ *
+ * Deals are spread over worker threads, each with its own PokerGame and
+ * its own agent instances.
+ */
+class MatchRunner {
+private:
+    MatchConfig config;
+    std::vector<std::string> names;
+    std::vector<AgentFactory> factories;
+
+public:
+    explicit MatchRunner(const MatchConfig& matchConfig);
+
+    /**
+     * @brief Add an agent; agent i sits in seat i in the first rotation
+     */
+    void addAgent(const std::string& name, const AgentFactory& factory);
+
+    /**
+     * @brief Play the match (2 to 9 agents)
+     * @param progress Optional callback with the running totals, serialized across threads
+     */
+    MatchResult run(const std::function<void(const MatchResult&)>& progress = nullptr);
+};
+
+#endif // MATCH_RUNNER_H
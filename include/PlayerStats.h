@@ -0,0 +1,128 @@
+#ifndef PLAYER_STATS_H
+#define PLAYER_STATS_H
+
+#include "HandRecord.h"
+#include <string>
+#include <vector>
+#include <functional>
+
+/**
+ * @brief Dimension a statistics query can group by
+ */
+enum class StatsGroup {
+    PLAYER,         // Screen name (or player id when the log has no name for it)
+    POSITION,       // BTN, SB, BB, UTG, MP, HJ, CO from the button
+    STACK_DEPTH,    // Starting stack in big blinds
+    BOARD_TEXTURE   // Flop: paired, monotone, two-tone, rainbow (or no flop)
+};
+
+/**
+ * @brief Hands kept by a statistics query
+ */
+struct StatsFilter {
+    enum Game { ALL_GAMES, CASH, TOURNAMENT };
+
+    std::string player;          // Only this screen name ("" = every player)
+    Game game = ALL_GAMES;
+    int minSeats = 2;            // Players dealt in
+    int maxSeats = HandRecord::MAX_SEATS;
+    int64_t from = 0;            // Timestamps (0 = unbounded)
+    int64_t to = 0;
+};
+
+/**
+ * @brief Query over a hand log
+ */
+struct StatsQuery {
+    std::vector<StatsGroup> groupBy; // Empty = a single row
+    StatsFilter filter;
+    long long minHands = 0;          // Rows with fewer hands are dropped
+    size_t maxRows = 0;              // Keep the rows with the most hands (0 = all)
+    int threads = 0;                 // Worker threads (0 = hardware concurrency)
+};
+
+/**
+ * @brief Counts behind the usual player statistics, summed over seat-hands
+ */
+struct StatsCounters {
+    long long hands = 0;
+    long long vpip = 0;              // Money put in preflop voluntarily
+    long long pfr = 0;               // Raised preflop
+    long long threeBetChances = 0;   // Acted preflop facing exactly one raise
+    long long threeBets = 0;
+    long long cbetChances = 0;       // Preflop raiser, first to bet on the flop
+    long long cbets = 0;
+    long long sawFlop = 0;
+    long long showdowns = 0;         // Saw the flop and reached showdown
+    long long showdownsWon = 0;
+    double netBb = 0.0;
+
+    void merge(const StatsCounters& other);
+
+    static double percent(long long count, long long chances) {
+        return chances > 0 ? 100.0 * count / chances : 0.0;
+    }
+    double bbPer100() const { return hands > 0 ? netBb * 100.0 / hands : 0.0; }
+};
+
+/**
+ * @brief One group of a query result
+ */
+struct StatsRow {
+    std::vector<std::string> labels; // One per grouping dimension
+    StatsCounters counters;
+};
+
+/**
+ * @brief Result of a statistics query, rows sorted by hands
+ */
+struct StatsTable {
+    std::vector<std::string> columns; // Names of the grouping dimensions
+    std::vector<StatsRow> rows;
+    StatsCounters total;             // Every matching seat-hand, rows dropped or not
+    long long scannedHands = 0;
+    long long bytes = 0;             // Size of the hand log
+    double seconds = 0.0;
+
+    std::string toString() const;
+
+    /**
+     * @brief Write the rows (throws std::runtime_error if the file cannot be written)
+     */
+    void writeCsv(const std::string& path) const;
+};
+
+/**
+ * @brief Parallel aggregation of player statistics over a hand log
+ *
+ * The log's blocks are handed out to worker threads in small batches; each
+ * thread decodes its hands with its own HandLogCursor and adds every seat
+ * matching the filter to a thread-local table keyed by the packed group
+ * values (player index in the log, position, stack bucket, texture). The
+ * tables are merged once all blocks are scanned, so no lock is taken per
+ * hand.
+ *
+ * Definitions: VPIP and PFR count calls and raises before the flop (blind
+ * posts excluded); a 3-bet chance is a preflop action facing exactly one
+ * raise; a c-bet chance is the last preflop raiser acting on the flop before
+ * any bet; showdowns are counted among hands that saw the flop, and won
+ * when the player collected chips.
+ */
+class PlayerStatsEngine {
+private:
+    StatsQuery query;
+
+public:
+    explicit PlayerStatsEngine(const StatsQuery& statsQuery);
+
+    /**
+     * @brief Run the query over a hand log (throws std::runtime_error)
+     * @param progress Optional callback (blocks scanned, total blocks)
+     */
+    StatsTable run(const std::string& logPath,
+                   const std::function<void(long long, long long)>& progress = nullptr) const;
+
+    static std::string groupName(StatsGroup group);
+};
+
+#endif // PLAYER_STATS_H
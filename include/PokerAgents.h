@@ -0,0 +1,40 @@
+#ifndef POKER_AGENTS_H
+#define POKER_AGENTS_H
+
+#include "PokerGame.h"
+#include <random>
+
+/**
+ * @brief Always checks or calls
+ */
+class CallingStationAgent : public PokerAgent {
+public:
+    Action act(const BettingState& state) override;
+};
+
+/**
+ * @brief Random legal actions with fixed frequencies, for testing and baselines
+ *
+ * Facing a bet it folds, raises (min-raise to pot-sized) or calls; with
+ * nothing to call it bets (half pot to pot) or checks.
+ */
+class RandomAgent : public PokerAgent {
+private:
+    double foldFrequency;
+    double raiseFrequency;
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> uniform;
+
+public:
+    /**
+     * @brief Constructor
+     * @param foldFreq Probability of folding facing a bet
+     * @param raiseFreq Probability of betting or raising
+     * @param seed Random seed
+     */
+    RandomAgent(double foldFreq = 0.3, double raiseFreq = 0.2, unsigned int seed = 12345);
+
+    Action act(const BettingState& state) override;
+};
+
+#endif // POKER_AGENTS_H
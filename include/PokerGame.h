@@ -4,8 +4,10 @@
 #include "Player.h"
 #include "Deck.h"
 #include "PotManager.h"
+#include "HandRecord.h"
 #include <vector>
 #include <string>
+#include <cstdint>
 
 /**
  * @brief Game phases
@@ -18,12 +20,111 @@ enum class GamePhase {
     SHOWDOWN
 };
 
+/**
+ * @brief Betting actions
+ */
+enum class ActionType {
+    FOLD,
+    CHECK,
+    CALL,
+    BET,     // First bet of a street (amount = total bet)
+    RAISE,   // Raise over the current bet (amount = total bet, "raise to")
+    ALL_IN   // Whole stack: resolved to a call, bet or raise
+};
+
+/**
+ * @brief Action chosen by an agent
+ */
+struct Action {
+    ActionType type;
+    int amount; // Total street bet for BET/RAISE, ignored otherwise
+
+    Action(ActionType t = ActionType::FOLD, int amt = 0) : type(t), amount(amt) {}
+
+    static Action fold() { return Action(ActionType::FOLD); }
+    static Action check() { return Action(ActionType::CHECK); }
+    static Action call() { return Action(ActionType::CALL); }
+    static Action bet(int total) { return Action(ActionType::BET, total); }
+    static Action raiseTo(int total) { return Action(ActionType::RAISE, total); }
+    static Action allIn() { return Action(ActionType::ALL_IN); }
+};
+
+/**
+ * @brief Action as it was applied (ALL_IN resolved to CALL, BET or RAISE)
+ */
+struct ActionRecord {
+    uint8_t seat;
+    GamePhase phase;
+    ActionType type;
+    int amount;  // Player's total street bet after the action
+    bool allIn;  // The action put the player all-in
+};
+
+/**
+ * @brief Everything an agent may look at when it is its turn to act
+ */
+struct BettingState {
+    int seat;
+    GamePhase phase;
+    int numPlayers;
+    int dealerPosition;
+    int bigBlind;
+    const Card* holeCards;                     // 2 cards
+    const std::vector<Card>& board;
+    const std::vector<ActionRecord>& history;  // Actions of the current hand
+    int pot;          // All chips committed so far, current street included
+    int currentBet;   // Highest street bet
+    int playerBet;    // Acting player's street bet
+    int stack;        // Acting player's remaining chips
+    int toCall;       // Chips needed to call (may exceed the stack)
+    bool canRaise;    // Betting is open to this player and they have chips left
+    int minRaiseTo;   // Smallest legal BET/RAISE total (capped at maxRaiseTo)
+    int maxRaiseTo;   // All-in total
+    int playersInHand;
+
+    /**
+     * @brief Check if possible, otherwise call
+     */
+    Action checkOrCall() const { return toCall > 0 ? Action::call() : Action::check(); }
+
+    /**
+     * @brief BET or RAISE to a total, clamped to the legal range
+     */
+    Action betOrRaise(int total) const;
+};
+
+/**
+ * @brief Decision maker plugged into a seat
+ */
+class PokerAgent {
+public:
+    virtual ~PokerAgent() {}
+
+    /**
+     * @brief Choose an action; illegal actions make PokerGame throw
+     */
+    virtual Action act(const BettingState& state) = 0;
+};
+
 /**
  * @brief Class managing a poker game
+ *
+ * Seats are driven by PokerAgent instances (check/call by default). A hand
+ * follows no-limit rules: a bet or raise must be at least the big blind
+ * and at least the previous raise increment, unless the player is all-in.
+ * A short all-in raise does not reopen the betting for players who have
+ * already acted. Folded chips stay in the pots as dead money, and side
+ * pots are built by PotManager at the end of every street. Seats without
+ * chips sit out. In silent mode nothing is printed, so hands can be
+ * simulated at full speed.
  */
 class PokerGame {
+public:
+    static const int MAX_PLAYERS = 9;
+
 private:
     std::vector<Player*> players;
+    std::vector<PokerAgent*> agents; // Not owned, nullptr = check/call
     Deck deck;
     PotManager potManager;
     std::vector<Card> board;
@@ -32,6 +133,22 @@ private:
     int smallBlind;
     int bigBlind;
     int currentPlayerIndex;
+    bool silent;
+
+    // Betting round state
+    int lastRaiseSize;
+    bool needsToAct[MAX_PLAYERS];
+    bool canReopen[MAX_PLAYERS];
+    std::vector<Card> dealtCards;    // Hole cards, 2 per seat
+    std::vector<ActionRecord> history;
+    std::vector<Card> dealScratch;
+
+    // Last hand, for exportHand
+    uint64_t playerIds[MAX_PLAYERS];
+    int handStartStacks[MAX_PLAYERS];
+    int handWinnings[MAX_PLAYERS];
+    int handDealer;
+    int blindSeats[2];
 
 public:
     /**
@@ -42,9 +159,12 @@ public:
      * @param startingStack Initial stack for each player
      */
     PokerGame(int numPlayers, int sb, int bb, int startingStack = 1000);
-    
+
     ~PokerGame();
 
+    PokerGame(const PokerGame&) = delete;
+    PokerGame& operator=(const PokerGame&) = delete;
+
     /**
      * @brief Start a new hand
      */
@@ -71,7 +191,7 @@ public:
     void dealRiver();
 
     /**
-     * @brief Betting round
+     * @brief Betting round: agents act until every bet is matched
      */
     void bettingRound();
 
@@ -81,15 +201,39 @@ public:
     void showdown();
 
     /**
-     * @brief Play a complete hand
+     * @brief Play a complete hand, then move the dealer button
      */
     void playHand();
 
+    /**
+     * @brief Apply one action for a seat (throws std::invalid_argument if illegal)
+     */
+    void applyAction(int seat, const Action& action);
+
+    /**
+     * @brief Describe the last hand played as a HandRecord (for hand logs)
+     *
+     * Seats that sat out are left out; amounts are in chips and hole cards
+     * of every seat dealt in are filled. The uncalled part of the largest
+     * bet is written as an UNCALLED action and left out of invested and
+     * collected, as in imported histories. Does not allocate.
+     * @return False if the hand has more actions than a HandRecord holds
+     */
+    bool exportHand(HandRecord& record, uint64_t handId) const;
+
     /**
      * @brief Display the current game state
      */
     void displayGameState() const;
 
+    /**
+     * @brief Configuration
+     */
+    void setAgent(int seat, PokerAgent* agent);
+    void setSilent(bool value) { silent = value; }
+    void setSeed(unsigned int seed) { deck.seed(seed); }
+    void setDealerPosition(int seat);
+
     /**
      * @brief Getters
      */
@@ -97,12 +241,20 @@ public:
     int getPotSize() const { return potManager.getTotalPot(); }
     GamePhase getCurrentPhase() const { return currentPhase; }
     std::vector<Player*> getActivePlayers() const;
+    int getNumPlayers() const { return static_cast<int>(players.size()); }
+    int getDealerPosition() const { return dealerPosition; }
+    Player* getPlayer(int seat) const { return players.at(seat); }
+    const std::vector<ActionRecord>& getActionHistory() const { return history; }
 
 private:
     void postBlinds();
     void moveDealer();
     int getNextActivePlayer(int startFrom);
+    int nextSeatWithChips(int startFrom) const;
     bool isRoundComplete();
+    int playersInHand() const;
+    BettingState makeBettingState(int seat) const;
+    void commitChips(Player* player, int chips);
 };
 
 #endif // POKER_GAME_H
@@ -5,6 +5,8 @@
 #include "Deck.h"
 #include "HandEvaluator.h"
 #include "Player.h"
+#include <cstdint>
+#include <random>
 #include <vector>
 #include <string>
 
@@ -29,10 +31,26 @@ struct DecisionResult {
     double expectedValue;  // EV of the decision
     bool shouldCall;       // Recommendation: Call or Fold
     std::string reasoning; // Explanation of the decision
+    bool prizeEquity = false; // EV in tournament prize equity ($EV) rather than chips
     
     std::string toString() const;
 };
 
+/**
+ * @brief Stacks after an all-in call is folded, won or lost
+ *
+ * When the hero is covered, the part of the bet they cannot match goes back
+ * to the villain in every outcome; the chips of stacks plus the pot are
+ * conserved.
+ */
+struct AllInOutcomes {
+    std::vector<double> afterFold;
+    std::vector<double> afterWin;
+    std::vector<double> afterLose;
+    int call;      // Chips the hero puts in (callAmount capped at the hero's stack)
+    int excess;    // Uncalled part of the bet, returned to the villain
+};
+
 /**
  * @brief Poker Solver/Assistant - Equity and EV calculation
  */
@@ -103,6 +121,52 @@ public:
         int simulations = 0
     );
 
+    /**
+     * @brief Builds the call/fold analysis from an equity already computed
+     * @param equity Equity result (e.g. accumulated over several runs)
+     * @param potSize Pot size
+     * @param callAmount Amount to call
+     */
+    DecisionResult decide(const EquityResult& equity, int potSize, int callAmount) const;
+
+    /**
+     * @brief Analyzes an all-in call/fold decision in tournament prize equity ($EV, ICM)
+     * @param holeCards Your cards
+     * @param board Community cards
+     * @param potSize Pot size, including the bet to call
+     * @param callAmount Amount to call (capped at your stack)
+     * @param numOpponents Number of opponents
+     * @param stacks Chips behind of every player at the table, excluding the pot
+     * @param heroSeat Your index in stacks
+     * @param villainSeat Index of the player who takes the pot if you fold or lose
+     * @param payouts Prize for each paid place, first place first
+     * @param simulations Number of simulations
+     * @return Decision analysis; potOdds holds the equity required under ICM
+     */
+    DecisionResult analyzeDecisionICM(
+        const std::vector<Card>& holeCards,
+        const std::vector<Card>& board,
+        int potSize,
+        int callAmount,
+        int numOpponents,
+        const std::vector<int>& stacks,
+        int heroSeat,
+        int villainSeat,
+        const std::vector<double>& payouts,
+        int simulations = 0
+    );
+
+    /**
+     * @brief Stacks after each outcome of an all-in call (see analyzeDecisionICM for the parameters)
+     */
+    static AllInOutcomes allInOutcomes(
+        const std::vector<int>& stacks,
+        int potSize,
+        int callAmount,
+        int heroSeat,
+        int villainSeat
+    );
+
     /**
      * @brief Calculates the Expected Value (EV) of a call
      * @param equity Equity (0.0 to 1.0)
@@ -114,14 +178,28 @@ public:
 
 private:
     /**
-     * @brief Simulates a complete hand and returns the winner
+     * @brief Dense-index deck and hands prepared by calculateEquity
      */
-    int simulateHand(
-        const std::vector<Card>& heroCards,
-        std::vector<Card> currentBoard,
-        int numOpponents,
-        const std::vector<Card>& deadCards
-    );
+    struct TrialSetup {
+        uint8_t* deck;       // Cards left, first `remaining` slots
+        int remaining;
+        uint8_t* hero;       // 7 slots, hole cards and known board filled
+        uint8_t* opponent;   // 7 slots, known board filled
+        int boardSize;
+        int numOpponents;
+    };
+
+    /**
+     * @brief Seed of the generator of one calculateEquity call
+     */
+    static unsigned int nextSeed();
+
+    /**
+     * @brief Monte Carlo trial loop of calculateEquity
+     * @tparam Timed Adds the per-phase tick counters to phaseTicks (instrumentation on)
+     */
+    template <bool Timed>
+    static EquityResult runTrials(const TrialSetup& setup, int simulations, std::mt19937& rng, uint64_t* phaseTicks);
 };
 
 #endif // POKER_SOLVER_H
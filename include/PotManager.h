@@ -4,24 +4,35 @@
 #include "Player.h"
 #include "HandEvaluator.h"
 #include <vector>
-#include <map>
+#include <cstdint>
 
 /**
  * @brief Represents a pot (main or side pot)
  */
 struct Pot {
     int amount;
-    std::vector<Player*> eligiblePlayers; // Players eligible to win this pot
-    
-    Pot() : amount(0) {}
+    uint16_t eligibleSeats; // Bitmask of the seats eligible to win this pot
+
+    Pot() : amount(0), eligibleSeats(0) {}
 };
 
 /**
  * @brief Manages the main pot and side pots
+ *
+ * Works on seat indices: pots live in a fixed array (one per all-in level,
+ * so at most one per seat) and eligibility is a seat bitmask, so building
+ * and splitting pots never allocates. The Player-based overloads map each
+ * player to its index in the vector given to calculatePots.
  */
 class PotManager {
+public:
+    static const int MAX_SEATS = 9;
+
 private:
-    std::vector<Pot> pots; // pots[0] est le pot principal
+    Pot pots[MAX_SEATS];   // pots[0] est le pot principal
+    int numPots;
+    int numSeats;
+    Player* seatPlayers[MAX_SEATS]; // Players passed to calculatePots, by seat
     int currentBet;        // Mise la plus élevée du tour actuel
 
 public:
@@ -34,14 +45,55 @@ public:
 
     /**
      * @brief Calculate pots (main and side pots) after a betting round
+     *
+     * Pot levels are set by players still in the hand; chips of folded
+     * players stay in the pots as dead money.
      */
     void calculatePots(std::vector<Player*>& players);
 
+    /**
+     * @brief Calculate pots from per-seat chips committed this hand
+     * @param contributions Chips committed by each seat
+     * @param liveSeats Bitmask of the seats still in the hand
+     * @param seats Number of seats (at most 9)
+     */
+    void calculatePots(const int* contributions, uint16_t liveSeats, int seats);
+
     /**
      * @brief Distribute pots to winners
      */
     void distributePots(const std::vector<std::pair<Player*, HandValue>>& playerHands);
 
+    /**
+     * @brief Split every pot by showdown scores (HandEvaluator scores, higher wins)
+     *
+     * Live hands are ranked once, then each pot goes to its best eligible
+     * hands in the same pass; odd chips go to the first winners clockwise
+     * from firstSeat.
+     * @param scores Score of each seat (ignored for seats not eligible to any pot)
+     * @param firstSeat Seat receiving odd chips first (left of the dealer)
+     * @param winnings Output, chips won by each seat
+     */
+    void distributePots(const int* scores, int firstSeat, int* winnings) const;
+
+    /**
+     * @brief Expected chips each player wins when all-in with cards to come
+     *
+     * Averages the pot split over every runout of the missing board cards,
+     * or over maxRunouts random runouts when there are more.
+     * @param holeCards Hole cards of every player (empty for folded players)
+     * @param board Current board (0 to 5 cards)
+     * @param contributions Chips each player put in the pot
+     * @param maxRunouts Enumeration limit and sample size (at least 1, std::invalid_argument otherwise)
+     * @param firstSeat Seat receiving odd chips first
+     * @param seed Sampling seed
+     */
+    static std::vector<double> allInExpectedWinnings(const std::vector<std::vector<Card>>& holeCards,
+                                                     const std::vector<Card>& board,
+                                                     const std::vector<int>& contributions,
+                                                     int maxRunouts, int firstSeat = 0,
+                                                     unsigned int seed = 12345);
+
     /**
      * @brief Get the total amount of all pots
      */
@@ -52,6 +104,12 @@ public:
      */
     int getMainPot() const;
 
+    /**
+     * @brief Main pot and side pots from the last calculatePots
+     */
+    int getNumPots() const { return numPots; }
+    const Pot& getPot(int index) const { return pots[index]; }
+
     /**
      * @brief Reset for a new hand
      */
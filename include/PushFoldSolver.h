@@ -0,0 +1,117 @@
+#ifndef PUSH_FOLD_SOLVER_H
+#define PUSH_FOLD_SOLVER_H
+
+#include "HandClass.h"
+#include <array>
+#include <vector>
+#include <string>
+
+/**
+ * @brief Jam/call frequency for each of the 169 hand classes (indexed by HandClass::index())
+ */
+typedef std::array<double, HandClass::COUNT> ClassStrategy;
+
+/**
+ * @brief Push/fold spot description (amounts in big blinds)
+ */
+struct PushFoldConfig {
+    int numPlayers = 2;           // 2 to 9
+    double stack = 10.0;          // Starting stack of every player
+    std::vector<double> stacks;   // Optional per-position stacks (action order), overrides stack
+    double smallBlind = 0.5;
+    double bigBlind = 1.0;
+    double ante = 0.0;            // Per-player ante
+    int maxIterations = 2000;     // Fictitious play iteration cap
+    double tolerance = 0.001;     // Stop when exploitability (bb) falls below
+};
+
+/**
+ * @brief Equilibrium jam and call ranges of a push/fold spot
+ *
+ * Positions are in preflop action order, following PokerGame's seating
+ * (small blind left of the dealer, big blind next): position 0 acts
+ * first and the last position is the big blind.
+ */
+struct PushFoldResult {
+    int numPlayers;
+    std::vector<double> stacks;
+    std::vector<ClassStrategy> jam;                // jam[opener] when folded to
+    std::vector<std::vector<ClassStrategy>> call;  // call[opener][caller]
+    double exploitability;                         // Sum of best-response gains (bb)
+    int iterations;
+
+    /**
+     * @brief Share of all 1326 combos in a range (0-100)
+     */
+    static double rangePercent(const ClassStrategy& strategy);
+
+    /**
+     * @brief Classes played at least half the time (e.g., "AA, KK, AKs, ...")
+     */
+    static std::string rangeString(const ClassStrategy& strategy);
+
+    /**
+     * @brief 13x13 chart ('#' >= 50%, '.' otherwise)
+     */
+    static std::string chart(const ClassStrategy& strategy);
+
+    std::string toString() const;
+};
+
+/**
+ * @brief Push/fold Nash equilibrium solver for short stacks
+ *
+ * Every player either folds or moves all-in first in, and players behind
+ * a jam either call or fold. Overcalls are not modeled: once someone calls,
+ * everybody behind folds, so every showdown is heads-up and is priced from
+ * a precomputed 169x169 class-vs-class all-in equity table with
+ * blocker-adjusted combo weights. Strategies are found by fictitious play
+ * (averaged best responses) over the 169 classes until the summed
+ * best-response gain drops below the tolerance.
+ */
+class PushFoldSolver {
+private:
+    int trialsPerMatchup;
+    std::string equityCachePath;
+    std::vector<float> equities;  // equities[hero * 169 + villain], all-in preflop equity
+    std::vector<float> weights;   // Average villain combos compatible with a hero combo
+    std::vector<double> weightedEquities; // weights * equities, for the range sweeps
+
+public:
+    /**
+     * @brief Constructor
+     * @param trials Monte Carlo boards per class matchup when building the equity table
+     * @param cachePath Equity table cache file (empty = no caching); a cached table
+     *                  built with fewer trials is rebuilt and overwritten
+     */
+    PushFoldSolver(int trials = 3000, const std::string& cachePath = "preflop_equity.bin");
+
+    /**
+     * @brief Solve one spot
+     */
+    PushFoldResult solve(const PushFoldConfig& config);
+
+    /**
+     * @brief Solve the same spot for every stack depth from minStack to maxStack
+     */
+    std::vector<PushFoldResult> solveChart(const PushFoldConfig& config,
+                                           double minStack, double maxStack, double step);
+
+    /**
+     * @brief All-in preflop equity of one class against another (0-1)
+     */
+    double equity(const HandClass& hero, const HandClass& villain);
+
+    /**
+     * @brief Position name ("UTG", ..., "BTN", "SB", "BB") for an action-order index
+     */
+    static std::string positionName(int position, int numPlayers);
+
+private:
+    void ensureTables();
+    void computeEquityTable();
+    bool loadEquityTable();
+    void saveEquityTable() const;
+};
+
+#endif // PUSH_FOLD_SOLVER_H
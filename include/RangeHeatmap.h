@@ -0,0 +1,130 @@
+#ifndef RANGE_HEATMAP_H
+#define RANGE_HEATMAP_H
+
+#include "Card.h"
+#include "HandClass.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Settings of a range heatmap computation
+ */
+struct HeatmapConfig {
+    std::vector<Card> board;      // Known community cards (0 to 5)
+    int numOpponents = 1;         // Random opponent hands
+    long long maxTrials = 200000; // Shared runouts before stopping, converged or not
+    double targetError = 0.005;   // Standard error (equity from 0 to 1) at which a cell converges
+    int minSamples = 400;         // Samples before a cell may converge
+    int roundTrials = 500;        // Runouts a thread simulates between two merges
+    int threads = 0;              // Worker threads (0 = hardware concurrency)
+};
+
+/**
+ * @brief Equity of one starting hand class
+ */
+struct HeatmapCell {
+    double equity = 0.0;          // 0 to 1, ties count half
+    double error = 1.0;           // Standard error of the equity
+    long long samples = 0;
+    bool possible = true;         // False when the board blocks every combo
+    bool converged = false;
+};
+
+/**
+ * @brief 13x13 grid of class equities (HandClass::index layout)
+ */
+struct HeatmapGrid {
+    HeatmapCell cells[HandClass::COUNT];
+    long long trials = 0;
+    int possibleCells = 0;
+    int convergedCells = 0;
+    bool fromCache = false;       // Taken from earlier computations, no new runout yet
+    bool final = false;           // Every possible cell converged, or maxTrials reached
+    uint64_t generation = 0;      // Request this grid answers
+
+    /**
+     * @brief Equities in percent on the 13x13 grid
+     */
+    std::string toString() const;
+};
+
+/**
+ * @brief Equity of all 169 starting hand classes on a board, for the GUI heatmap
+ *
+ * Each trial deals one runout of the board and the opponents' hands, shared
+ * by every cell: the opponents' best score is computed once, then each
+ * class not yet converged gets one of its combos not blocked by those
+ * cards, weighted by the number of such combos so that blockers do not
+ * bias the estimate. Converged cells are no longer sampled.
+ *
+ * Worker threads simulate rounds into thread-local sums and merge them
+ * into the cache entry of the board, canonicalized over suit permutations
+ * (class equities do not depend on suits), then report the grid. Requests
+ * are numbered as in LiveSolver: a new one supersedes the running
+ * computation, which stops at its next round, and its runouts stay in the
+ * cache.
+ */
+class RangeHeatmap {
+private:
+    struct Sums {
+        double weight = 0.0;
+        double weighted = 0.0;
+        double weightedSquares = 0.0;
+        double squaredWeights = 0.0;
+        long long samples = 0;
+    };
+
+    struct Entry {
+        std::vector<uint8_t> board;   // Canonical board
+        int numOpponents = 1;
+        long long trials = 0;
+        bool possible[HandClass::COUNT];
+        Sums sums[HandClass::COUNT];
+    };
+
+    size_t maxCacheEntries;
+    std::atomic<uint64_t> generation;
+    mutable std::mutex cacheMutex;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> cache;
+
+    static std::string canonicalKey(const std::vector<Card>& board, int numOpponents, std::vector<uint8_t>& canonical);
+    static void fillGrid(const Entry& entry, const HeatmapConfig& config, HeatmapGrid& grid);
+
+public:
+    /**
+     * @param cacheEntries Boards kept before the cache is emptied
+     */
+    explicit RangeHeatmap(size_t cacheEntries = 256);
+
+    /**
+     * @brief Start a new generation, superseding every running computation
+     */
+    uint64_t supersede();
+
+    bool isCurrent(uint64_t requestGeneration) const { return generation.load() == requestGeneration; }
+
+    /**
+     * @brief Cached grid of a board, without simulating (false if never computed)
+     */
+    bool cached(const HeatmapConfig& config, HeatmapGrid& grid) const;
+
+    /**
+     * @brief Compute the grid progressively (throws std::invalid_argument on bad input)
+     * @param requestGeneration Value returned by supersede() for this request
+     * @param onUpdate Called from a worker thread after each merged round (one call at a time)
+     * @return False if superseded before the grid was final
+     */
+    bool compute(const HeatmapConfig& config, uint64_t requestGeneration,
+                 const std::function<void(const HeatmapGrid&)>& onUpdate);
+
+    size_t getCacheSize() const;
+    void clearCache();
+};
+
+#endif // RANGE_HEATMAP_H
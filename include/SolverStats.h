@@ -0,0 +1,131 @@
+#ifndef SOLVER_STATS_H
+#define SOLVER_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Timed phases of a solver query
+ */
+enum class SolverPhase {
+    SETUP = 0,      // Argument checks, dead cards, deck building
+    DEAL = 1,       // Drawing the missing board and opponent cards
+    EVALUATE = 2,   // Hand evaluation
+    AGGREGATE = 3,  // Win/tie/loss counting and merging of results
+    WAIT = 4        // Worker threads blocked on a lock or on other workers
+};
+
+/**
+ * @brief Snapshot of the solver counters since the last reset
+ */
+struct SolverStats {
+    static const int PHASE_COUNT = 5;
+
+    bool enabled = false;
+    double seconds = 0.0;               // Wall time since the last reset
+    double ticksPerSecond = 0.0;        // Tick rate measured over that time
+    uint64_t queries = 0;               // Equity computations (calls or heatmap requests)
+    uint64_t trials = 0;                // Monte Carlo trials (runouts)
+    uint64_t evaluations = 0;           // Hands evaluated
+    uint64_t phaseTicks[PHASE_COUNT] = {0, 0, 0, 0, 0};
+    uint64_t cacheHits = 0;             // LiveSolver and RangeHeatmap lookups
+    uint64_t cacheMisses = 0;
+    uint64_t workerTicks = 0;           // Time of the worker threads, busy or waiting
+
+    static const char* phaseName(int phase);
+
+    double cacheHitRate() const;
+    /**
+     * @brief Share of worker thread time not spent waiting (1 = never blocked)
+     */
+    double threadUtilization() const;
+    double trialsPerSecond() const;
+
+    std::string toString() const;
+};
+
+/**
+ * @brief Process-wide solver instrumentation, off by default
+ *
+ * Counters are global atomics updated once per query, chunk or round from
+ * totals kept in local variables: instrumented loops never touch shared
+ * memory per trial. When disabled, the only cost is one relaxed load of the
+ * flag per query, after which the uninstrumented loop runs. Times are read
+ * from the CPU timestamp counter where available (steady_clock otherwise)
+ * and converted with the rate measured between the last reset and the
+ * snapshot.
+ */
+class Instrumentation {
+private:
+    static std::atomic<bool> active;
+    static std::atomic<uint64_t> queries;
+    static std::atomic<uint64_t> trials;
+    static std::atomic<uint64_t> evaluations;
+    static std::atomic<uint64_t> phaseTicks[SolverStats::PHASE_COUNT];
+    static std::atomic<uint64_t> cacheHits;
+    static std::atomic<uint64_t> cacheMisses;
+    static std::atomic<uint64_t> workerTicks;
+    static std::atomic<uint64_t> startTicks;
+    static std::atomic<int64_t> startNanos;
+
+    static int64_t nanos();
+
+public:
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Turn counting on or off; turning it on resets the counters
+     */
+    static void setEnabled(bool on);
+
+    static void reset();
+
+    /**
+     * @brief Counters since the last reset
+     */
+    static SolverStats stats();
+
+    /**
+     * @brief Current tick count (timestamp counter or nanoseconds)
+     */
+    static uint64_t ticks() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Recording, called with totals accumulated by the caller
+    static void addQuery(uint64_t numTrials, uint64_t numEvaluations) {
+        queries.fetch_add(1, std::memory_order_relaxed);
+        trials.fetch_add(numTrials, std::memory_order_relaxed);
+        evaluations.fetch_add(numEvaluations, std::memory_order_relaxed);
+    }
+    static void addTrials(uint64_t numTrials, uint64_t numEvaluations) {
+        trials.fetch_add(numTrials, std::memory_order_relaxed);
+        evaluations.fetch_add(numEvaluations, std::memory_order_relaxed);
+    }
+    static void addEvaluations(uint64_t numEvaluations) {
+        evaluations.fetch_add(numEvaluations, std::memory_order_relaxed);
+    }
+    static void addPhase(SolverPhase phase, uint64_t elapsedTicks) {
+        phaseTicks[static_cast<int>(phase)].fetch_add(elapsedTicks, std::memory_order_relaxed);
+    }
+    static void addCacheLookup(bool hit) {
+        (hit ? cacheHits : cacheMisses).fetch_add(1, std::memory_order_relaxed);
+    }
+    static void addWorkerTime(uint64_t elapsedTicks) {
+        workerTicks.fetch_add(elapsedTicks, std::memory_order_relaxed);
+    }
+};
+
+#endif // SOLVER_STATS_H
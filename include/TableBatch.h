@@ -0,0 +1,180 @@
+#ifndef TABLE_BATCH_H
+#define TABLE_BATCH_H
+
+#include "PokerGame.h"
+#include <vector>
+#include <random>
+#include <cstdint>
+
+class TableBatch;
+
+/**
+ * @brief Agent deciding for one seat on many tables at once
+ */
+class BatchAgent {
+public:
+    virtual ~BatchAgent() {}
+
+    /**
+     * @brief Choose an action on every listed table, where this seat is to act
+     * @param batch Tables (read-only accessors)
+     * @param seat Acting seat
+     * @param tables Indices of the tables waiting on this seat
+     * @param count Number of tables
+     * @param actions Output, one action per listed table
+     */
+    virtual void act(const TableBatch& batch, int seat, const int* tables, int count, Action* actions) = 0;
+};
+
+/**
+ * @brief Bets and raises with strong made hands, calls with medium ones
+ *
+ * Uses the per-street hand scores kept by TableBatch. Checks or calls preflop.
+ */
+class HandStrengthBatchAgent : public BatchAgent {
+private:
+    HandRank valueRank; // Bet/raise pot from this rank up
+    HandRank callRank;  // Call from this rank up, fold below when facing a bet
+
+public:
+    HandStrengthBatchAgent(HandRank value = HandRank::TWO_PAIR, HandRank call = HandRank::PAIR);
+
+    void act(const TableBatch& batch, int seat, const int* tables, int count, Action* actions) override;
+};
+
+/**
+ * @brief Many independent no-limit tables stepped in lockstep
+ *
+ * Data-oriented counterpart of PokerGame for bot-versus-bot evaluation:
+ * every per-seat field (stack, street bet, chips committed, status, hole
+ * cards, current hand score) is a flat array indexed by
+ * table * numPlayers + seat, and every per-table field (board, deck,
+ * current bet, pending seat, bitmasks of seats still to act) is an array
+ * indexed by table. Nothing is allocated while hands are played.
+ *
+ * Each step() collects the tables waiting on each seat and asks that
+ * seat's BatchAgent for all of them in one call. Tables that reach a new
+ * street queue their live hands, and one HandEvaluator::evaluateScores
+ * call per step scores them all; showdowns reuse the river scores.
+ *
+ * Betting follows PokerGame's rules (minimum raise, short all-ins do not
+ * reopen betting, dead money stays in the pots). Every hand starts with
+ * all players at the starting stack, and the button moves each hand;
+ * netResult() accumulates chips won per seat across tables and hands.
+ */
+class TableBatch {
+public:
+    static const int MAX_PLAYERS = PokerGame::MAX_PLAYERS;
+
+private:
+    int numTables;
+    int numPlayers;
+    int smallBlind;
+    int bigBlind;
+    int startingStack;
+    std::vector<BatchAgent*> agents; // Not owned, nullptr = check/call
+    std::mt19937 rng;
+
+    // Per seat (table * numPlayers + seat)
+    std::vector<int32_t> stacks;
+    std::vector<int32_t> streetBets;
+    std::vector<int32_t> committed;
+    std::vector<uint8_t> statuses;   // PlayerStatus
+    std::vector<uint8_t> holeCards;  // 2 card indices per seat
+    std::vector<int32_t> handScores; // Best hand with the current board (0 preflop)
+
+    // Per table
+    std::vector<uint8_t> decks;      // 52 card indices per table
+    std::vector<uint8_t> boards;     // 5 card indices per table
+    std::vector<uint8_t> boardSizes;
+    std::vector<uint8_t> phases;     // GamePhase
+    std::vector<uint8_t> dealers;
+    std::vector<int8_t> toAct;       // Seat to act, -1 = hand over or awaiting showdown
+    std::vector<int32_t> currentBets;
+    std::vector<int32_t> lastRaises;
+    std::vector<uint16_t> needsToAct; // Seat bitmask
+    std::vector<uint16_t> canReopen;  // Seat bitmask
+    std::vector<uint8_t> awaitingShowdown;
+
+    // Scratch
+    std::vector<std::vector<int>> tablesBySeat;
+    std::vector<Action> actionScratch;
+    std::vector<uint8_t> evalCards;
+    std::vector<uint8_t> evalCounts;
+    std::vector<int32_t> evalScores;
+    std::vector<int32_t> evalOwners; // Seat index of each queued hand
+
+    std::vector<long long> netResults; // Per seat, summed over tables
+    long long handsPlayed;
+
+public:
+    /**
+     * @brief Constructor
+     * @param tables Number of tables
+     * @param players Players per table (2 to 9)
+     * @param sb Small blind
+     * @param bb Big blind
+     * @param stack Stack of every player at the start of each hand
+     * @param seed Random seed for the deals
+     */
+    TableBatch(int tables, int players, int sb, int bb, int stack = 1000, unsigned int seed = 12345);
+
+    void setAgent(int seat, BatchAgent* agent);
+
+    /**
+     * @brief Deal a new hand on every table (blinds posted, hole cards dealt)
+     */
+    void startHands();
+
+    /**
+     * @brief One decision on every table still in a hand
+     * @return false once every table has finished its hand
+     */
+    bool step();
+
+    /**
+     * @brief Play one full hand on every table
+     */
+    void playHands();
+
+    /**
+     * @brief Per-table and per-seat accessors, for agents
+     */
+    int getNumTables() const { return numTables; }
+    int getNumPlayers() const { return numPlayers; }
+    int getBigBlind() const { return bigBlind; }
+    GamePhase phase(int table) const { return static_cast<GamePhase>(phases[table]); }
+    int dealer(int table) const { return dealers[table]; }
+    int pot(int table) const;
+    int currentBet(int table) const { return currentBets[table]; }
+    int stack(int table, int seat) const { return stacks[table * numPlayers + seat]; }
+    int streetBet(int table, int seat) const { return streetBets[table * numPlayers + seat]; }
+    int toCall(int table, int seat) const;
+    bool canRaise(int table, int seat) const;
+    int minRaiseTo(int table, int seat) const;
+    int maxRaiseTo(int table, int seat) const;
+    const uint8_t* hole(int table, int seat) const { return &holeCards[2 * (table * numPlayers + seat)]; }
+    const uint8_t* board(int table) const { return &boards[5 * table]; }
+    int boardSize(int table) const { return boardSizes[table]; }
+    int handScore(int table, int seat) const { return handScores[table * numPlayers + seat]; }
+
+    /**
+     * @brief Chips won (negative = lost) by a seat over every table and hand so far
+     */
+    long long netResult(int seat) const { return netResults.at(seat); }
+    long long getHandsPlayed() const { return handsPlayed; }
+
+private:
+    void applyAction(int table, int seat, const Action& action);
+    void advance(int table, int from);
+    void startStreet(int table);
+    void dealStreet(int table);
+    void finishHand(int table);
+    void showdown(int table);
+    void flushEvaluations();
+    void commitChips(int table, int seat, int chips);
+    int playersInHand(int table) const;
+    int playersWithChips(int table) const;
+};
+
+#endif // TABLE_BATCH_H
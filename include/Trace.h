@@ -0,0 +1,110 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief One completed span ("X" event of the Chrome trace format)
+ */
+struct TraceEvent {
+    const char* name = nullptr;      // String literal, not copied
+    const char* category = nullptr;  // String literal, not copied
+    int64_t startNanos = 0;
+    int64_t endNanos = 0;
+    int64_t value = -1;              // Optional argument (-1 = none)
+    uint32_t thread = 0;             // Trace thread number
+};
+
+/**
+ * @brief Timeline of solver jobs, exported as Chrome trace JSON (chrome://tracing, Perfetto)
+ *
+ * Each thread records its spans into its own ring buffer: the owner is the
+ * only writer, publishing each event with a release store of its counter,
+ * so recording takes no lock and never waits. Buffers are allocated the
+ * first time a thread records while tracing is on, and reused by later
+ * threads once their owner exits (solver pools start threads per job).
+ * A full buffer overwrites its oldest spans.
+ *
+ * Tracing is switched at runtime. While off, a span costs one relaxed load
+ * of the flag; while on, two clock reads and one store into the buffer.
+ * Export can run during a job: event fields are relaxed atomics read as a
+ * seqlock (copy, acquire fence, re-read of the counter), so spans
+ * overwritten while being copied are dropped rather than reported torn.
+ */
+class Trace {
+public:
+    static const size_t BUFFER_EVENTS = 16384;  // Spans kept per thread
+
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Start or stop recording (recorded spans are kept until clear())
+     */
+    static void setEnabled(bool on);
+
+    /**
+     * @brief Forget every recorded span
+     */
+    static void clear();
+
+    /**
+     * @brief Record a completed span of the calling thread
+     */
+    static void record(const char* name, const char* category, int64_t startNanos, int64_t endNanos,
+                       int64_t value = -1);
+
+    static int64_t now();
+
+    /**
+     * @brief Spans currently held in the buffers
+     */
+    static size_t eventCount();
+
+    /**
+     * @brief Chrome trace JSON of the recorded spans (times in microseconds)
+     */
+    static std::string toChromeJson();
+
+    /**
+     * @brief Write toChromeJson() to a file (throws std::runtime_error if it cannot be written)
+     * @return Number of spans written
+     */
+    static size_t writeChromeJson(const std::string& path);
+
+private:
+    static std::atomic<bool> active;
+};
+
+/**
+ * @brief Scoped span: records [construction, destruction) when tracing is on
+ */
+class TraceSpan {
+private:
+    const char* name;
+    const char* category;
+    int64_t value;
+    int64_t start;
+
+public:
+    TraceSpan(const char* spanName, const char* spanCategory, int64_t spanValue = -1)
+        : name(Trace::enabled() ? spanName : nullptr), category(spanCategory), value(spanValue),
+          start(name ? Trace::now() : 0) {}
+
+    ~TraceSpan() {
+        if (name) {
+            Trace::record(name, category, start, Trace::now(), value);
+        }
+    }
+
+    /**
+     * @brief Set the span argument once known (e.g. items processed)
+     */
+    void setValue(int64_t spanValue) { value = spanValue; }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+#endif // TRACE_H
@@ -0,0 +1,449 @@
+#include "../include/AllInAnalyzer.h"
+#include "PotManager.h"
+#include "HandLog.h"
+#include "PokerGame.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+    const int EQUAL_CONTRIBUTION = 720720; // Divisible par 1 à 16: partages exacts, sans jeton impair
+    const int EXACT_RUNOUTS = 2000000;     // Plus que C(48, 5): toujours une énumération complète
+
+    struct SuitPermutations {
+        int map[24][4];
+
+        SuitPermutations() {
+            int suits[4] = {0, 1, 2, 3};
+            int p = 0;
+            do {
+                std::copy(suits, suits + 4, map[p++]);
+            } while (std::next_permutation(suits, suits + 4));
+        }
+    };
+    const SuitPermutations SUIT_PERMUTATIONS;
+
+    inline uint8_t relabel(uint8_t card, const int* suitMap) {
+        return static_cast<uint8_t>(suitMap[card / 13] * 13 + card % 13);
+    }
+
+    // Clé canonique des mains d'un spot: nombre de mains, taille du tableau, mains triées
+    // puis tableau trié, la plus petite sur les 24 permutations de couleurs.
+    // order[i] reçoit l'indice d'origine de la main en position i.
+    std::string canonicalSpot(const uint8_t (*hands)[2], int count, const uint8_t* board, int boardCount,
+                              int* order) {
+        const int length = 2 + 2 * count + boardCount;
+        uint8_t best[2 + 2 * HandRecord::MAX_SEATS + 5];
+        uint8_t candidate[sizeof(best)];
+        bool first = true;
+
+        for (const auto& suitMap : SUIT_PERMUTATIONS.map) {
+            uint8_t mapped[HandRecord::MAX_SEATS][2];
+            int candidateOrder[HandRecord::MAX_SEATS];
+            for (int i = 0; i < count; i++) {
+                uint8_t a = relabel(hands[i][0], suitMap);
+                uint8_t b = relabel(hands[i][1], suitMap);
+                mapped[i][0] = std::max(a, b);
+                mapped[i][1] = std::min(a, b);
+                candidateOrder[i] = i;
+            }
+            std::sort(candidateOrder, candidateOrder + count, [&](int x, int y) {
+                return mapped[x][0] != mapped[y][0] ? mapped[x][0] > mapped[y][0] : mapped[x][1] > mapped[y][1];
+            });
+
+            candidate[0] = static_cast<uint8_t>(count);
+            candidate[1] = static_cast<uint8_t>(boardCount);
+            for (int i = 0; i < count; i++) {
+                candidate[2 + 2 * i] = mapped[candidateOrder[i]][0];
+                candidate[3 + 2 * i] = mapped[candidateOrder[i]][1];
+            }
+            uint8_t* mappedBoard = candidate + 2 + 2 * count;
+            for (int i = 0; i < boardCount; i++) {
+                mappedBoard[i] = relabel(board[i], suitMap);
+            }
+            std::sort(mappedBoard, mappedBoard + boardCount);
+
+            if (first || std::memcmp(candidate, best, length) < 0) {
+                std::memcpy(best, candidate, length);
+                std::copy(candidateOrder, candidateOrder + count, order);
+                first = false;
+            }
+        }
+        return std::string(reinterpret_cast<const char*>(best), length);
+    }
+
+    // Part de chaque main dans chaque pot disputé d'une clé canonique, sur tous les tirages.
+    // Les mains non éligibles à un pot y restent en jeu sans mise: leurs cartes sont mortes.
+    std::vector<double> enumerateShares(const std::string& key) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(key.data());
+        const int count = bytes[0];
+        const int boardCount = bytes[1];
+        const uint8_t* pots = bytes + 2 + 2 * count + boardCount;
+        const int numPots = pots[0];
+
+        std::vector<std::vector<Card>> holeCards(count);
+        for (int i = 0; i < count; i++) {
+            holeCards[i] = {Card::fromIndex(bytes[2 + 2 * i]), Card::fromIndex(bytes[3 + 2 * i])};
+        }
+        std::vector<Card> board;
+        for (int i = 0; i < boardCount; i++) {
+            board.push_back(Card::fromIndex(bytes[2 + 2 * count + i]));
+        }
+
+        std::vector<double> shares(numPots * count, 0.0);
+        for (int p = 0; p < numPots; p++) {
+            const unsigned mask = pots[1 + 2 * p] | (pots[2 + 2 * p] << 8);
+            std::vector<int> contributions(count, 0);
+            int eligible = 0;
+            for (int i = 0; i < count; i++) {
+                if (mask & (1u << i)) {
+                    contributions[i] = EQUAL_CONTRIBUTION;
+                    eligible++;
+                }
+            }
+
+            std::vector<double> winnings = PotManager::allInExpectedWinnings(
+                holeCards, board, contributions, EXACT_RUNOUTS);
+            for (int i = 0; i < count; i++) {
+                shares[p * count + i] = winnings[i] / (static_cast<double>(EQUAL_CONTRIBUTION) * eligible);
+            }
+        }
+        return shares;
+    }
+
+    void addHand(LuckSession& session, int64_t timestamp, double netBb, double evNetBb, bool allIn) {
+        if (session.hands == 0) session.start = timestamp;
+        session.end = timestamp;
+        session.hands++;
+        session.allIns += allIn ? 1 : 0;
+        session.netBb += netBb;
+        session.evNetBb += evNetBb;
+    }
+
+    // "AAAA/MM/JJ HH:MM" d'un horodatage de HandRecord
+    std::string formatTimestamp(int64_t timestamp) {
+        int64_t days = timestamp >= 0 ? timestamp / 86400 : (timestamp - 86399) / 86400;
+        int64_t seconds = timestamp - days * 86400;
+
+        days += 719468;
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const int64_t dayOfEra = days - era * 146097;
+        const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+        const int64_t day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+        const int64_t month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+        const int64_t year = yearOfEra + era * 400 + (month <= 2);
+
+        std::ostringstream oss;
+        oss << std::setfill('0') << std::setw(4) << year << "/" << std::setw(2) << month << "/"
+            << std::setw(2) << day << " " << std::setw(2) << seconds / 3600 << ":"
+            << std::setw(2) << (seconds / 60) % 60;
+        return oss.str();
+    }
+
+    double per100(double bb, long long hands) {
+        return hands > 0 ? bb * 100.0 / hands : 0.0;
+    }
+}
+
+std::string LuckReport::toString() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "=== All-in Luck Report: " << player << " ===\n";
+    oss << "Hands: " << total.hands << "   All-in hands: " << total.allIns << "   Time: " << seconds << "s\n";
+    oss << "Equity spots: " << equitySpots << " (" << computedSpots << " enumerated, the rest cached)\n";
+    oss << "Net won: " << total.netBb << " bb (" << per100(total.netBb, total.hands) << " bb/100)\n";
+    oss << "All-in adjusted: " << total.evNetBb << " bb (" << per100(total.evNetBb, total.hands) << " bb/100)\n";
+    oss << "Luck: " << total.luckBb() << " bb\n";
+    oss << "Sessions: " << sessions.size() << "\n";
+    for (const auto& session : sessions) {
+        oss << "  " << formatTimestamp(session.start) << "  " << std::setw(6) << session.hands << " hands  "
+            << std::setw(4) << session.allIns << " all-ins  net " << std::setw(9) << session.netBb
+            << " bb  adjusted " << std::setw(9) << session.evNetBb << " bb  luck " << std::setw(9)
+            << session.luckBb() << " bb\n";
+    }
+    return oss.str();
+}
+
+void LuckReport::writeCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+    out << "session,start,end,hands,all_ins,net_bb,adjusted_net_bb,luck_bb\n";
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < sessions.size(); i++) {
+        const LuckSession& session = sessions[i];
+        out << (i + 1) << "," << formatTimestamp(session.start) << "," << formatTimestamp(session.end) << ","
+            << session.hands << "," << session.allIns << "," << session.netBb << ","
+            << session.evNetBb << "," << session.luckBb() << "\n";
+    }
+}
+
+AllInAnalyzer::AllInAnalyzer(const AllInConfig& analysisConfig) : config(analysisConfig) {
+}
+
+LuckReport AllInAnalyzer::analyze(const std::string& recordPath,
+                                  const std::function<void(long long, long long)>& progress) {
+    auto start = std::chrono::steady_clock::now();
+
+    LuckReport report;
+    report.player = config.player.empty() ? "hero" : config.player;
+    const bool hero = config.player.empty();
+    const uint64_t playerId = HandRecord::playerId(config.player.data(), config.player.size());
+
+    struct HandResult {
+        int64_t timestamp;
+        double netBb;
+        double evNetBb;
+        bool allIn;
+    };
+    // Part du joueur dans un pot disputé, à résoudre par l'équité du spot
+    struct PotShare {
+        size_t hand;
+        double amountBb;
+        std::string key;
+        size_t index; // Pot disputé * nombre de mains + position canonique du joueur
+    };
+
+    std::vector<HandResult> hands;
+    std::vector<PotShare> potShares;
+    std::vector<std::string> pending;
+    std::unordered_set<std::string> pendingKeys;
+
+    // Fichier d'enregistrements ou journal compressé
+    std::unique_ptr<HandRecordReader> reader;
+    std::unique_ptr<HandLog> handLog;
+    std::unique_ptr<HandLogCursor> cursor;
+    if (HandLog::isHandLog(recordPath)) {
+        handLog.reset(new HandLog(recordPath));
+        cursor.reset(new HandLogCursor(*handLog));
+    } else {
+        reader.reset(new HandRecordReader(recordPath));
+    }
+    HandLogEntry entry;
+    auto nextRecord = [&](HandRecord& out) {
+        if (reader) return reader->next(out);
+        if (!cursor->next(entry)) return false;
+        entry.toRecord(out);
+        return true;
+    };
+
+    HandRecord record;
+    while (nextRecord(record)) {
+        int seat = -1;
+        for (int s = 0; s < record.numSeats; s++) {
+            if (hero ? (record.seats[s].flags & HistorySeat::HERO) != 0 : record.seats[s].playerId == playerId) {
+                seat = s;
+                break;
+            }
+        }
+        if (seat < 0 || record.bigBlind <= 0) continue;
+
+        const HistorySeat& me = record.seats[seat];
+        const double bb = record.bigBlind;
+        HandResult result;
+        result.timestamp = record.timestamp;
+        result.netBb = (me.collected - me.invested) / bb;
+        result.evNetBb = result.netBb;
+        result.allIn = false;
+
+        // Dernière mise ou abandon: le moment où le tableau restant est devenu sans décision
+        int spotStreet = -1;
+        for (int a = 0; a < record.numActions; a++) {
+            HistoryActionType type = record.actions[a].type;
+            if (type != HistoryActionType::CHECK && type != HistoryActionType::UNCALLED) {
+                spotStreet = record.actions[a].street;
+            }
+        }
+
+        bool spot = spotStreet >= 0 && spotStreet < static_cast<int>(GamePhase::RIVER) &&
+                    record.boardCount == 5 && !(me.flags & HistorySeat::FOLDED);
+
+        // Sièges ayant misé, compactés pour PotManager
+        int contributions[PotManager::MAX_SEATS];
+        uint8_t holeCards[PotManager::MAX_SEATS][2];
+        uint16_t liveSeats = 0;
+        int numCompact = 0;
+        int liveCount = 0;
+        int mySeat = -1;
+        bool anyAllIn = false;
+        int64_t totalInvested = 0;
+        int64_t totalCollected = 0;
+
+        for (int s = 0; spot && s < record.numSeats; s++) {
+            const HistorySeat& other = record.seats[s];
+            const bool live = !(other.flags & HistorySeat::FOLDED);
+            totalInvested += other.invested;
+            totalCollected += other.collected;
+            if (!live && other.invested <= 0) continue;
+            if (numCompact == PotManager::MAX_SEATS ||
+                (live && (other.cards[0] == HandRecord::NO_CARD || other.cards[1] == HandRecord::NO_CARD))) {
+                spot = false;
+                break;
+            }
+            if (live) {
+                liveSeats |= 1u << numCompact;
+                liveCount++;
+                anyAllIn = anyAllIn || (other.flags & HistorySeat::ALL_IN);
+                holeCards[numCompact][0] = other.cards[0];
+                holeCards[numCompact][1] = other.cards[1];
+            }
+            if (s == seat) mySeat = numCompact;
+            contributions[numCompact++] = std::max(0, static_cast<int>(other.invested));
+        }
+
+        if (spot && liveCount >= 2 && anyAllIn && totalInvested > 0) {
+            PotManager pots;
+            pots.calculatePots(contributions, liveSeats, numCompact);
+
+            // Le râteau est prélevé en proportion du pot, comme dans le résultat réel
+            const double rakeFactor = static_cast<double>(totalCollected) / totalInvested;
+            const int boardCount = spotStreet == static_cast<int>(GamePhase::PRE_FLOP) ? 0 : spotStreet + 2;
+
+            result.allIn = true;
+            result.evNetBb = -me.invested / bb;
+
+            // Toutes les mains en jeu comptent (cartes mortes) même dans les pots où elles ne sont pas éligibles
+            uint8_t liveHands[PotManager::MAX_SEATS][2];
+            int liveIndex[PotManager::MAX_SEATS];
+            int numLive = 0;
+            for (int s = 0; s < numCompact; s++) {
+                liveIndex[s] = -1;
+                if (!(liveSeats & (1u << s))) continue;
+                liveIndex[s] = numLive;
+                liveHands[numLive][0] = holeCards[s][0];
+                liveHands[numLive][1] = holeCards[s][1];
+                numLive++;
+            }
+            int order[PotManager::MAX_SEATS];
+            int position[PotManager::MAX_SEATS];
+            std::string key = canonicalSpot(liveHands, numLive, record.board, boardCount, order);
+            for (int i = 0; i < numLive; i++) {
+                position[order[i]] = i;
+            }
+
+            // Pots disputés: masques d'éligibilité en positions canoniques, ajoutés à la clé
+            size_t contestedShares[PotManager::MAX_SEATS];
+            double contestedAmounts[PotManager::MAX_SEATS];
+            int numShares = 0;
+            int numContested = 0;
+            std::string masks;
+            for (int p = 0; p < pots.getNumPots(); p++) {
+                const Pot& pot = pots.getPot(p);
+                const double amountBb = pot.amount * rakeFactor / bb;
+                uint16_t mask = 0;
+                int eligible = 0;
+                for (int s = 0; s < numCompact; s++) {
+                    if (!(pot.eligibleSeats & (1u << s))) continue;
+                    mask |= static_cast<uint16_t>(1u << position[liveIndex[s]]);
+                    eligible++;
+                }
+                const bool mine = (pot.eligibleSeats & (1u << mySeat)) != 0;
+
+                if (eligible == 1) {
+                    if (mine) result.evNetBb += amountBb;
+                    continue;
+                }
+                if (mine) {
+                    contestedShares[numShares] = numContested * numLive + position[liveIndex[mySeat]];
+                    contestedAmounts[numShares++] = amountBb;
+                }
+                masks.push_back(static_cast<char>(mask & 0xFF));
+                masks.push_back(static_cast<char>(mask >> 8));
+                numContested++;
+            }
+            key.push_back(static_cast<char>(numContested));
+            key += masks;
+
+            if (numShares > 0) {
+                report.equitySpots++;
+                if (cache.find(key) == cache.end() && pendingKeys.insert(key).second) {
+                    pending.push_back(key);
+                }
+                for (int i = 0; i < numShares; i++) {
+                    potShares.push_back({hands.size(), contestedAmounts[i], key, contestedShares[i]});
+                }
+            }
+        }
+
+        hands.push_back(result);
+    }
+
+    // Énumération des nouveaux spots en parallèle
+    std::vector<std::vector<double>> computed(pending.size());
+    std::atomic<size_t> next(0);
+    std::mutex progressMutex;
+    long long done = 0;
+    std::exception_ptr failure;
+
+    int numThreads = config.threads > 0
+        ? config.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    numThreads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(numThreads, pending.size())));
+
+    auto worker = [&]() {
+        try {
+            size_t i;
+            while ((i = next++) < pending.size()) {
+                computed[i] = enumerateShares(pending[i]);
+                if (progress) {
+                    std::lock_guard<std::mutex> lock(progressMutex);
+                    progress(++done, static_cast<long long>(pending.size()));
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            if (!failure) failure = std::current_exception();
+            next = pending.size();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < numThreads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    for (size_t i = 0; i < pending.size(); i++) {
+        cache.emplace(std::move(pending[i]), std::move(computed[i]));
+    }
+    report.computedSpots = static_cast<long long>(pending.size());
+
+    for (const auto& share : potShares) {
+        hands[share.hand].evNetBb += share.amountBb * cache.at(share.key)[share.index];
+    }
+
+    // Sessions: mains triées par date, coupées aux pauses
+    std::stable_sort(hands.begin(), hands.end(), [](const HandResult& a, const HandResult& b) {
+        return a.timestamp < b.timestamp;
+    });
+    const int64_t gap = static_cast<int64_t>(config.sessionGapMinutes) * 60;
+    for (const auto& hand : hands) {
+        if (report.sessions.empty() || hand.timestamp - report.sessions.back().end > gap) {
+            report.sessions.emplace_back();
+        }
+        addHand(report.sessions.back(), hand.timestamp, hand.netBb, hand.evNetBb, hand.allIn);
+        addHand(report.total, hand.timestamp, hand.netBb, hand.evNetBb, hand.allIn);
+    }
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
@@ -0,0 +1,102 @@
+#include "../include/AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+#ifdef POKERSOLVER_COUNT_ALLOCATIONS
+namespace {
+    // Compteurs sans initialisation dynamique: utilisables avant main et pendant la sortie des threads
+    thread_local uint64_t allocationCount = 0;
+    thread_local uint64_t allocationBytes = 0;
+
+    void* countedAllocate(std::size_t size) {
+        allocationCount++;
+        allocationBytes += size;
+        if (size == 0) size = 1;
+        for (;;) {
+            if (void* memory = std::malloc(size)) {
+                return memory;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void* countedAllocateNoThrow(std::size_t size) noexcept {
+        try {
+            return countedAllocate(size);
+        } catch (...) {
+            return nullptr;
+        }
+    }
+}
+
+bool AllocationCounter::enabled() {
+    return true;
+}
+
+uint64_t AllocationCounter::threadAllocations() {
+    return allocationCount;
+}
+
+uint64_t AllocationCounter::threadBytes() {
+    return allocationBytes;
+}
+
+// Remplacements globaux: seulement dans les binaires de test et de mesure
+
+void* operator new(std::size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return countedAllocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocateNoThrow(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocateNoThrow(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+#else
+// Compteur absent: l'allocateur standard reste en place
+bool AllocationCounter::enabled() {
+    return false;
+}
+
+uint64_t AllocationCounter::threadAllocations() {
+    return 0;
+}
+
+uint64_t AllocationCounter::threadBytes() {
+    return 0;
+}
+#endif // POKERSOLVER_COUNT_ALLOCATIONS
@@ -0,0 +1,72 @@
+#include "../include/Arena.h"
+#include <algorithm>
+#include <new>
+
+Arena::Arena(size_t blockBytes)
+    : blockSize(std::max<size_t>(256, blockBytes)), current(0), used(0) {
+}
+
+Arena::~Arena() {
+    release();
+}
+
+void* Arena::allocate(size_t bytes, size_t alignment) {
+    // Bloc courant puis blocs suivants déjà réservés (gardés après un retour en arrière)
+    while (current < blocks.size()) {
+        const Block& block = blocks[current];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+        const uintptr_t aligned = (base + used + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        const size_t offset = static_cast<size_t>(aligned - base);
+        if (offset + bytes <= block.size) {
+            used = offset + bytes;
+            return block.data + offset;
+        }
+        current++;
+        used = 0;
+    }
+
+    // Nouveau bloc, à la taille de la demande si elle dépasse la taille normale
+    const size_t size = std::max(blockSize, bytes + alignment);
+    Block block{static_cast<char*>(::operator new(size)), size};
+    blocks.push_back(block);
+    current = blocks.size() - 1;
+    used = 0;
+    return allocate(bytes, alignment);
+}
+
+void Arena::rewind(const Mark& mark) {
+    if (mark.block < current || (mark.block == current && mark.used < used)) {
+        current = mark.block;
+        used = mark.used;
+    }
+}
+
+void Arena::release() {
+    for (const Block& block : blocks) {
+        ::operator delete(block.data);
+    }
+    blocks.clear();
+    current = 0;
+    used = 0;
+}
+
+size_t Arena::getBytesUsed() const {
+    size_t total = used;
+    for (size_t b = 0; b < current && b < blocks.size(); b++) {
+        total += blocks[b].size;
+    }
+    return total;
+}
+
+size_t Arena::getBytesReserved() const {
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+Arena& Arena::forThread() {
+    thread_local Arena arena;
+    return arena;
+}
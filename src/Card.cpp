@@ -86,6 +86,48 @@ Card Card::fromString(const std::string& str) {
     return Card(r, s);
 }
 
+int Card::parseIndex(const char* text) {
+    int rank;
+    switch (std::toupper(static_cast<unsigned char>(text[0]))) {
+        case '2': rank = 2; break;
+        case '3': rank = 3; break;
+        case '4': rank = 4; break;
+        case '5': rank = 5; break;
+        case '6': rank = 6; break;
+        case '7': rank = 7; break;
+        case '8': rank = 8; break;
+        case '9': rank = 9; break;
+        case 'T': rank = 10; break;
+        case 'J': rank = 11; break;
+        case 'Q': rank = 12; break;
+        case 'K': rank = 13; break;
+        case 'A': rank = 14; break;
+        default: return -1;
+    }
+
+    int suit;
+    switch (std::tolower(static_cast<unsigned char>(text[1]))) {
+        case 'h': suit = static_cast<int>(Suit::HEARTS); break;
+        case 'd': suit = static_cast<int>(Suit::DIAMONDS); break;
+        case 'c': suit = static_cast<int>(Suit::CLUBS); break;
+        case 's': suit = static_cast<int>(Suit::SPADES); break;
+        default: return -1;
+    }
+
+    return suit * 13 + (rank - 2);
+}
+
+int Card::toIndex() const {
+    return static_cast<int>(suit) * 13 + (static_cast<int>(rank) - 2);
+}
+
+Card Card::fromIndex(int index) {
+    if (index < 0 || index >= 52) {
+        throw std::invalid_argument("Invalid card index: " + std::to_string(index));
+    }
+    return Card(static_cast<Rank>(index % 13 + 2), static_cast<Suit>(index / 13));
+}
+
 bool Card::operator<(const Card& other) const {
     if (rank != other.rank) {
         return rank < other.rank;
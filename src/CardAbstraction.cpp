@@ -0,0 +1,410 @@
+#include "../include/CardAbstraction.h"
+#include "../include/HandEvaluator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const char BUCKET_MAGIC[4] = {'P', 'S', 'B', 'M'};
+const uint32_t BUCKET_VERSION = 1;
+
+// Run fn(begin, end) over [0, n) split into contiguous chunks, one per thread
+void parallelFor(int n, int threads, const std::function<void(int, int)>& fn) {
+    if (threads <= 1 || n <= 1) {
+        fn(0, n);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    int chunk = (n + threads - 1) / threads;
+    for (int begin = 0; begin < n; begin += chunk) {
+        int end = std::min(n, begin + chunk);
+        workers.emplace_back(fn, begin, end);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Earth mover's distance between two 1-D histograms given as CDFs
+float emd(const float* cdfA, const float* cdfB, int bins) {
+    float sum = 0.0f;
+    for (int i = 0; i < bins; i++) {
+        sum += std::fabs(cdfA[i] - cdfB[i]);
+    }
+    return sum / bins;
+}
+
+struct ScoredCombo {
+    int score;
+    uint8_t card1;
+    uint8_t card2;
+    int16_t combo;
+};
+
+// River hand strength vs a random hand for every live combo, with exact card removal
+void accumulateRunout(const uint8_t* fullBoard, uint64_t deadMask, int bins,
+                      std::vector<float>& histograms, std::vector<ScoredCombo>& scratch) {
+    scratch.clear();
+
+    uint8_t cards[7];
+    std::memcpy(cards + 2, fullBoard, 5);
+
+    for (int a = 0; a < 52; a++) {
+        if (deadMask & (1ULL << a)) continue;
+        for (int b = a + 1; b < 52; b++) {
+            if (deadMask & (1ULL << b)) continue;
+            cards[0] = static_cast<uint8_t>(a);
+            cards[1] = static_cast<uint8_t>(b);
+            scratch.push_back({HandEvaluator::evaluateScore(cards, 7),
+                               static_cast<uint8_t>(a), static_cast<uint8_t>(b),
+                               static_cast<int16_t>(BucketMap::comboIndex(a, b))});
+        }
+    }
+
+    std::sort(scratch.begin(), scratch.end(),
+              [](const ScoredCombo& x, const ScoredCombo& y) { return x.score < y.score; });
+
+    const int liveCards = 52 - 5; // Full board is dead
+    double opponents = (liveCards - 2) * (liveCards - 3) / 2.0;
+
+    int lessWithCard[52] = {0};
+    int equalWithCard[52] = {0};
+    int processed = 0;
+    int n = static_cast<int>(scratch.size());
+
+    for (int i = 0; i < n;) {
+        int j = i;
+        while (j < n && scratch[j].score == scratch[i].score) {
+            equalWithCard[scratch[j].card1]++;
+            equalWithCard[scratch[j].card2]++;
+            j++;
+        }
+        int groupSize = j - i;
+
+        for (int k = i; k < j; k++) {
+            const ScoredCombo& h = scratch[k];
+            int less = processed - lessWithCard[h.card1] - lessWithCard[h.card2];
+            int equal = groupSize - equalWithCard[h.card1] - equalWithCard[h.card2] + 1;
+            double strength = (less + 0.5 * equal) / opponents;
+
+            int bin = std::min(bins - 1, static_cast<int>(strength * bins));
+            histograms[static_cast<size_t>(h.combo) * bins + bin] += 1.0f;
+        }
+
+        for (int k = i; k < j; k++) {
+            lessWithCard[scratch[k].card1]++;
+            lessWithCard[scratch[k].card2]++;
+            equalWithCard[scratch[k].card1] = 0;
+            equalWithCard[scratch[k].card2] = 0;
+        }
+        processed += groupSize;
+        i = j;
+    }
+}
+
+} // namespace
+
+// ==================== BucketMap ====================
+
+int BucketMap::comboIndex(int card1, int card2) {
+    if (card1 > card2) std::swap(card1, card2);
+    return card2 * (card2 - 1) / 2 + card1;
+}
+
+int BucketMap::bucketOf(const Card& c1, const Card& c2) const {
+    if (bucketOfCombo.empty()) return -1;
+    return bucketOfCombo[comboIndex(c1.toIndex(), c2.toIndex())];
+}
+
+void BucketMap::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write bucket map: " + path);
+    }
+
+    uint8_t boardCount = static_cast<uint8_t>(board.size());
+    int32_t buckets = numBuckets;
+
+    out.write(BUCKET_MAGIC, sizeof(BUCKET_MAGIC));
+    out.write(reinterpret_cast<const char*>(&BUCKET_VERSION), sizeof(BUCKET_VERSION));
+    out.write(reinterpret_cast<const char*>(&boardCount), sizeof(boardCount));
+    for (const auto& card : board) {
+        uint8_t idx = static_cast<uint8_t>(card.toIndex());
+        out.write(reinterpret_cast<const char*>(&idx), sizeof(idx));
+    }
+    out.write(reinterpret_cast<const char*>(&buckets), sizeof(buckets));
+    out.write(reinterpret_cast<const char*>(&meanDistance), sizeof(meanDistance));
+    out.write(reinterpret_cast<const char*>(bucketOfCombo.data()),
+              bucketOfCombo.size() * sizeof(int16_t));
+}
+
+BucketMap BucketMap::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot read bucket map: " + path);
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!in || std::memcmp(magic, BUCKET_MAGIC, sizeof(magic)) != 0 || version != BUCKET_VERSION) {
+        throw std::runtime_error("Not a bucket map file: " + path);
+    }
+
+    BucketMap map;
+    uint8_t boardCount = 0;
+    in.read(reinterpret_cast<char*>(&boardCount), sizeof(boardCount));
+    for (int i = 0; i < boardCount; i++) {
+        uint8_t idx = 0;
+        in.read(reinterpret_cast<char*>(&idx), sizeof(idx));
+        map.board.push_back(Card::fromIndex(idx));
+    }
+
+    int32_t buckets = 0;
+    in.read(reinterpret_cast<char*>(&buckets), sizeof(buckets));
+    in.read(reinterpret_cast<char*>(&map.meanDistance), sizeof(map.meanDistance));
+    map.numBuckets = buckets;
+
+    map.bucketOfCombo.resize(NUM_COMBOS);
+    in.read(reinterpret_cast<char*>(map.bucketOfCombo.data()), NUM_COMBOS * sizeof(int16_t));
+    if (!in) {
+        throw std::runtime_error("Truncated bucket map file: " + path);
+    }
+
+    return map;
+}
+
+// ==================== CardAbstraction ====================
+
+CardAbstraction::CardAbstraction(const AbstractionConfig& cfg) : config(cfg) {
+    if (config.buckets < 1 || config.histogramBins < 1) {
+        throw std::invalid_argument("Buckets and histogram bins must be positive");
+    }
+}
+
+int CardAbstraction::threadCount(int work) const {
+    int threads = config.threads > 0
+        ? config.threads
+        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    return std::max(1, std::min(threads, work));
+}
+
+std::vector<float> CardAbstraction::equityHistograms(const std::vector<Card>& board) const {
+    if (board.size() < 3 || board.size() > 5) {
+        throw std::invalid_argument("Board must have 3 to 5 cards");
+    }
+
+    const int bins = config.histogramBins;
+    uint64_t boardMask = 0;
+    std::vector<uint8_t> boardIdx;
+    for (const auto& card : board) {
+        uint64_t bit = 1ULL << card.toIndex();
+        if (boardMask & bit) {
+            throw std::invalid_argument("Duplicate board card: " + card.toString());
+        }
+        boardMask |= bit;
+        boardIdx.push_back(static_cast<uint8_t>(card.toIndex()));
+    }
+
+    // Every completion of the board to five cards
+    std::vector<std::vector<uint8_t>> runouts;
+    int missing = 5 - static_cast<int>(board.size());
+    if (missing == 0) {
+        runouts.push_back({});
+    } else {
+        for (int a = 0; a < 52; a++) {
+            if (boardMask & (1ULL << a)) continue;
+            if (missing == 1) {
+                runouts.push_back({static_cast<uint8_t>(a)});
+                continue;
+            }
+            for (int b = a + 1; b < 52; b++) {
+                if (boardMask & (1ULL << b)) continue;
+                runouts.push_back({static_cast<uint8_t>(a), static_cast<uint8_t>(b)});
+            }
+        }
+    }
+
+    std::vector<float> histograms(static_cast<size_t>(BucketMap::NUM_COMBOS) * bins, 0.0f);
+    std::mutex mergeMutex;
+
+    parallelFor(static_cast<int>(runouts.size()), threadCount(static_cast<int>(runouts.size())),
+                [&](int begin, int end) {
+        std::vector<float> local(histograms.size(), 0.0f);
+        std::vector<ScoredCombo> scratch;
+        scratch.reserve(1081);
+
+        uint8_t fullBoard[5];
+        std::copy(boardIdx.begin(), boardIdx.end(), fullBoard);
+
+        for (int r = begin; r < end; r++) {
+            uint64_t deadMask = boardMask;
+            for (size_t i = 0; i < runouts[r].size(); i++) {
+                fullBoard[boardIdx.size() + i] = runouts[r][i];
+                deadMask |= 1ULL << runouts[r][i];
+            }
+            accumulateRunout(fullBoard, deadMask, bins, local, scratch);
+        }
+
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        for (size_t i = 0; i < histograms.size(); i++) {
+            histograms[i] += local[i];
+        }
+    });
+
+    // Normalize each combo's row to a distribution
+    for (int combo = 0; combo < BucketMap::NUM_COMBOS; combo++) {
+        float* row = &histograms[static_cast<size_t>(combo) * bins];
+        float total = std::accumulate(row, row + bins, 0.0f);
+        if (total > 0.0f) {
+            for (int b = 0; b < bins; b++) row[b] /= total;
+        }
+    }
+
+    return histograms;
+}
+
+BucketMap CardAbstraction::build(const std::vector<Card>& board) const {
+    const int bins = config.histogramBins;
+    std::vector<float> histograms = equityHistograms(board);
+
+    // Live combos and their CDFs
+    std::vector<int> combos;
+    std::vector<float> cdfs;
+    for (int combo = 0; combo < BucketMap::NUM_COMBOS; combo++) {
+        const float* row = &histograms[static_cast<size_t>(combo) * bins];
+        if (std::accumulate(row, row + bins, 0.0f) <= 0.0f) continue;
+
+        combos.push_back(combo);
+        float running = 0.0f;
+        for (int b = 0; b < bins; b++) {
+            running += row[b];
+            cdfs.push_back(running);
+        }
+    }
+
+    const int n = static_cast<int>(combos.size());
+    const int k = std::min(config.buckets, n);
+    auto cdfOf = [&](int i) { return &cdfs[static_cast<size_t>(i) * bins]; };
+
+    // k-means++ seeding
+    std::mt19937 rng(config.seed);
+    std::vector<float> centroids;
+    centroids.reserve(static_cast<size_t>(k) * bins);
+    std::vector<float> nearest(n, std::numeric_limits<float>::max());
+
+    int first = std::uniform_int_distribution<int>(0, n - 1)(rng);
+    centroids.insert(centroids.end(), cdfOf(first), cdfOf(first) + bins);
+
+    for (int c = 1; c < k; c++) {
+        const float* last = &centroids[static_cast<size_t>(c - 1) * bins];
+        double total = 0.0;
+        for (int i = 0; i < n; i++) {
+            float d = emd(cdfOf(i), last, bins);
+            nearest[i] = std::min(nearest[i], d * d);
+            total += nearest[i];
+        }
+
+        int pick = 0;
+        if (total > 0.0) {
+            double target = std::uniform_real_distribution<double>(0.0, total)(rng);
+            for (double acc = 0.0; pick < n - 1; pick++) {
+                acc += nearest[pick];
+                if (acc >= target) break;
+            }
+        } else {
+            pick = std::uniform_int_distribution<int>(0, n - 1)(rng);
+        }
+        centroids.insert(centroids.end(), cdfOf(pick), cdfOf(pick) + bins);
+    }
+
+    // Lloyd iterations: parallel assignment, serial centroid update
+    std::vector<int> assignment(n, -1);
+    std::vector<float> distance(n, 0.0f);
+    int threads = threadCount(n / 64 + 1);
+
+    for (int iter = 0; iter < config.maxIterations; iter++) {
+        std::mutex changedMutex;
+        int changed = 0;
+
+        parallelFor(n, threads, [&](int begin, int end) {
+            int localChanged = 0;
+            for (int i = begin; i < end; i++) {
+                int best = 0;
+                float bestDist = std::numeric_limits<float>::max();
+                for (int c = 0; c < k; c++) {
+                    float d = emd(cdfOf(i), &centroids[static_cast<size_t>(c) * bins], bins);
+                    if (d < bestDist) {
+                        bestDist = d;
+                        best = c;
+                    }
+                }
+                if (assignment[i] != best) localChanged++;
+                assignment[i] = best;
+                distance[i] = bestDist;
+            }
+            std::lock_guard<std::mutex> lock(changedMutex);
+            changed += localChanged;
+        });
+
+        if (changed == 0) break;
+
+        std::vector<int> members(k, 0);
+        std::fill(centroids.begin(), centroids.end(), 0.0f);
+        for (int i = 0; i < n; i++) {
+            float* centroid = &centroids[static_cast<size_t>(assignment[i]) * bins];
+            const float* cdf = cdfOf(i);
+            for (int b = 0; b < bins; b++) centroid[b] += cdf[b];
+            members[assignment[i]]++;
+        }
+
+        for (int c = 0; c < k; c++) {
+            float* centroid = &centroids[static_cast<size_t>(c) * bins];
+            if (members[c] > 0) {
+                for (int b = 0; b < bins; b++) centroid[b] /= members[c];
+                continue;
+            }
+            // Empty cluster: reseed on the worst-fit combo
+            int worst = static_cast<int>(std::max_element(distance.begin(), distance.end()) - distance.begin());
+            std::copy(cdfOf(worst), cdfOf(worst) + bins, centroid);
+            distance[worst] = 0.0f;
+        }
+    }
+
+    // Number buckets from weakest to strongest mean equity
+    std::vector<double> meanEquity(k, 0.0);
+    for (int c = 0; c < k; c++) {
+        const float* centroid = &centroids[static_cast<size_t>(c) * bins];
+        for (int b = 0; b < bins; b++) meanEquity[c] += (1.0 - centroid[b]) / bins;
+    }
+    std::vector<int> order(k);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return meanEquity[a] < meanEquity[b]; });
+    std::vector<int16_t> rename(k);
+    for (int i = 0; i < k; i++) rename[order[i]] = static_cast<int16_t>(i);
+
+    BucketMap map;
+    map.board = board;
+    map.numBuckets = k;
+    map.bucketOfCombo.assign(BucketMap::NUM_COMBOS, -1);
+
+    double totalDistance = 0.0;
+    for (int i = 0; i < n; i++) {
+        map.bucketOfCombo[combos[i]] = rename[assignment[i]];
+        totalDistance += distance[i];
+    }
+    map.meanDistance = n > 0 ? totalDistance / n : 0.0;
+
+    return map;
+}
@@ -11,6 +11,10 @@ Deck::Deck() : currentIndex(0) {
     reset();
 }
 
+void Deck::seed(unsigned int value) {
+    rng.seed(value);
+}
+
 void Deck::shuffle() {
     std::shuffle(cards.begin(), cards.end(), rng);
     currentIndex = 0;
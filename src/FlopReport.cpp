@@ -0,0 +1,349 @@
+#include "../include/FlopReport.h"
+#include "../include/HandClass.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const char* CSV_HEADER = "flop,weight,win,tie,lose,equity,simulations,combos";
+const std::string MATCHUP_PREFIX = "# matchup ";
+
+// First line of a results file: rows are only resumed under the same matchup
+std::string matchupLine(const FlopReportConfig& config) {
+    std::ostringstream oss;
+    oss << MATCHUP_PREFIX << "hero=" << config.heroHand;
+    if (config.villainHand.empty()) {
+        oss << " villain=random opponents=" << config.numOpponents;
+    } else {
+        oss << " villain=" << config.villainHand;
+    }
+    oss << " simulations=" << config.simulations;
+    return oss.str();
+}
+
+bool sharesCard(const std::vector<Card>& a, const std::vector<Card>& b) {
+    for (const auto& x : a) {
+        if (std::find(b.begin(), b.end(), x) != b.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+std::string FlopSummary::toCsvRow() const {
+    std::ostringstream oss;
+    for (const auto& card : flop) {
+        oss << card.toString();
+    }
+    oss << std::fixed << std::setprecision(4);
+    oss << "," << weight << "," << winRate << "," << tieRate << "," << loseRate
+        << "," << (winRate + tieRate / 2.0) << "," << simulations << "," << combos;
+    return oss.str();
+}
+
+FlopReport::FlopReport(const FlopReportConfig& cfg) : config(cfg), solver(cfg.simulations) {
+    if (config.simulations <= 0) {
+        throw std::invalid_argument("Simulations per flop must be positive");
+    }
+    if (config.villainHand.empty() && (config.numOpponents < 1 || config.numOpponents > 9)) {
+        throw std::invalid_argument("Number of opponents must be between 1 and 9");
+    }
+
+    // Validate the matchup up front rather than in a worker thread
+    HandClass::fromString(config.heroHand);
+    if (!config.villainHand.empty()) {
+        HandClass::fromString(config.villainHand);
+    }
+}
+
+std::vector<Card> FlopReport::canonicalBoard(const std::vector<Card>& board) {
+    std::vector<int> best;
+    int perm[4] = {0, 1, 2, 3};
+
+    do {
+        std::vector<int> mapped;
+        mapped.reserve(board.size());
+        for (const auto& card : board) {
+            int suit = perm[static_cast<int>(card.getSuit())];
+            mapped.push_back(suit * 13 + (card.getRankValue() - 2));
+        }
+        std::sort(mapped.begin(), mapped.end());
+
+        if (best.empty() || mapped < best) {
+            best = mapped;
+        }
+    } while (std::next_permutation(perm, perm + 4));
+
+    std::vector<Card> result;
+    result.reserve(best.size());
+    for (int idx : best) {
+        result.push_back(Card::fromIndex(idx));
+    }
+    return result;
+}
+
+std::vector<std::pair<std::vector<Card>, int>> FlopReport::canonicalFlops() {
+    std::map<std::vector<int>, int> weights;
+
+    for (int a = 0; a < 52; a++) {
+        for (int b = a + 1; b < 52; b++) {
+            for (int c = b + 1; c < 52; c++) {
+                std::vector<Card> flop = {Card::fromIndex(a), Card::fromIndex(b), Card::fromIndex(c)};
+                std::vector<int> key;
+                for (const auto& card : canonicalBoard(flop)) {
+                    key.push_back(card.toIndex());
+                }
+                weights[key]++;
+            }
+        }
+    }
+
+    std::vector<std::pair<std::vector<Card>, int>> result;
+    result.reserve(weights.size());
+    for (const auto& entry : weights) {
+        std::vector<Card> flop;
+        for (int idx : entry.first) {
+            flop.push_back(Card::fromIndex(idx));
+        }
+        result.emplace_back(flop, entry.second);
+    }
+    return result;
+}
+
+FlopSummary FlopReport::solveFlop(const std::vector<Card>& flop, int weight) {
+    std::vector<std::vector<Card>> heroCombos;
+    for (const auto& combo : HandClass::fromString(config.heroHand).combos()) {
+        std::vector<Card> hand = {combo.first, combo.second};
+        if (!sharesCard(hand, flop)) {
+            heroCombos.push_back(hand);
+        }
+    }
+
+    // (hero, villain) pairs; villain empty = random opponents
+    std::vector<std::pair<std::vector<Card>, std::vector<Card>>> matchups;
+    for (const auto& hero : heroCombos) {
+        if (config.villainHand.empty()) {
+            matchups.emplace_back(hero, std::vector<Card>());
+            continue;
+        }
+        for (const auto& combo : HandClass::fromString(config.villainHand).combos()) {
+            std::vector<Card> villain = {combo.first, combo.second};
+            if (!sharesCard(villain, flop) && !sharesCard(villain, hero)) {
+                matchups.emplace_back(hero, villain);
+            }
+        }
+    }
+
+    FlopSummary summary;
+    summary.flop = flop;
+    summary.weight = weight;
+    summary.winRate = summary.tieRate = summary.loseRate = 0.0;
+    summary.simulations = 0;
+    summary.combos = static_cast<int>(matchups.size());
+
+    if (matchups.empty()) {
+        return summary; // Matchup impossible on this flop (all combos blocked)
+    }
+
+    int simsPerMatchup = std::max(1, config.simulations / static_cast<int>(matchups.size()));
+    double wins = 0.0, ties = 0.0, losses = 0.0;
+
+    for (const auto& matchup : matchups) {
+        EquityResult eq = matchup.second.empty()
+            ? solver.calculateEquity(matchup.first, flop, config.numOpponents, simsPerMatchup)
+            : solver.calculateEquityVsHands(matchup.first, flop, {matchup.second}, simsPerMatchup);
+
+        wins += eq.winRate * simsPerMatchup;
+        ties += eq.tieRate * simsPerMatchup;
+        losses += eq.loseRate * simsPerMatchup;
+        summary.simulations += simsPerMatchup;
+    }
+
+    summary.winRate = wins / summary.simulations;
+    summary.tieRate = ties / summary.simulations;
+    summary.loseRate = losses / summary.simulations;
+    return summary;
+}
+
+int FlopReport::run(const std::function<void(int, int)>& progress) {
+    auto flops = canonicalFlops();
+    std::string storedMatchup;
+    std::vector<FlopSummary> completed = loadCompleted(config.outputPath, &storedMatchup);
+    const std::string matchup = matchupLine(config);
+    if (!completed.empty() && storedMatchup != matchup) {
+        throw std::runtime_error(config.outputPath + " holds results of another matchup ("
+                                 + (storedMatchup.empty() ? std::string("unknown") : storedMatchup.substr(MATCHUP_PREFIX.size()))
+                                 + "); use another results file");
+    }
+
+    std::set<std::string> done;
+    for (const auto& summary : completed) {
+        done.insert(flopKey(summary.flop));
+    }
+
+    // Rewrite the valid rows so a torn trailing line from a crash is dropped
+    std::string tmpPath = config.outputPath + ".tmp";
+    {
+        std::ofstream tmp(tmpPath, std::ios::trunc);
+        if (!tmp) {
+            throw std::runtime_error("Cannot write " + tmpPath);
+        }
+        tmp << matchup << "\n" << CSV_HEADER << "\n";
+        for (const auto& summary : completed) {
+            tmp << summary.toCsvRow() << "\n";
+        }
+    }
+    // Atomic replace on POSIX; remove first only where an existing target blocks the rename (Windows)
+    if (std::rename(tmpPath.c_str(), config.outputPath.c_str()) != 0) {
+        std::remove(config.outputPath.c_str());
+        if (std::rename(tmpPath.c_str(), config.outputPath.c_str()) != 0) {
+            throw std::runtime_error("Cannot replace " + config.outputPath);
+        }
+    }
+
+    std::vector<std::pair<std::vector<Card>, int>> pending;
+    for (const auto& flop : flops) {
+        if (done.find(flopKey(flop.first)) == done.end()) {
+            pending.push_back(flop);
+        }
+    }
+
+    std::ofstream out(config.outputPath, std::ios::app);
+    if (!out) {
+        throw std::runtime_error("Cannot open " + config.outputPath);
+    }
+
+    TraceSpan span("flop report", "job", static_cast<int64_t>(pending.size()));
+    int total = static_cast<int>(flops.size());
+    int finished = total - static_cast<int>(pending.size());
+    std::atomic<size_t> next(0);
+    std::mutex outMutex;
+
+    // Every flop is a small independent equity query, so flops are spread
+    // across workers rather than parallelizing inside a single flop.
+    int numThreads = config.threads > 0
+        ? config.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    numThreads = std::max(1, std::min(numThreads, static_cast<int>(pending.size())));
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < pending.size(); i = next++) {
+            FlopSummary summary;
+            {
+                TraceSpan flop("flop", "chunk", static_cast<int64_t>(i));
+                summary = solveFlop(pending[i].first, pending[i].second);
+            }
+
+            TraceSpan checkpoint("report row", "checkpoint");
+            std::lock_guard<std::mutex> lock(outMutex);
+            out << summary.toCsvRow() << "\n";
+            out.flush();
+            finished++;
+            if (progress) {
+                progress(finished, total);
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < numThreads; t++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    return static_cast<int>(pending.size());
+}
+
+EquityResult FlopReport::aggregate(const std::string& path) {
+    EquityResult result;
+    result.winRate = result.tieRate = result.loseRate = 0.0;
+    result.simulations = 0;
+
+    // A flop that blocks combos of either hand is dealt less often with this matchup
+    double totalWeight = 0.0;
+    for (const auto& summary : loadCompleted(path)) {
+        if (summary.simulations == 0) continue;
+        const double weight = static_cast<double>(summary.weight) * summary.combos;
+        result.winRate += summary.winRate * weight;
+        result.tieRate += summary.tieRate * weight;
+        result.loseRate += summary.loseRate * weight;
+        result.simulations += summary.simulations;
+        totalWeight += weight;
+    }
+
+    if (totalWeight > 0) {
+        result.winRate /= totalWeight;
+        result.tieRate /= totalWeight;
+        result.loseRate /= totalWeight;
+    }
+    return result;
+}
+
+std::string FlopReport::flopKey(const std::vector<Card>& flop) {
+    std::string key;
+    for (const auto& card : flop) {
+        key += card.toString();
+    }
+    return key;
+}
+
+std::vector<FlopSummary> FlopReport::loadCompleted(const std::string& path, std::string* matchup) {
+    std::vector<FlopSummary> result;
+    std::ifstream in(path);
+    if (!in) {
+        return result;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (in.eof()) {
+            break; // Unterminated last line: the write was interrupted
+        }
+        if (line.compare(0, MATCHUP_PREFIX.size(), MATCHUP_PREFIX) == 0) {
+            if (matchup) *matchup = line;
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        std::istringstream iss(line);
+        std::string field;
+        while (std::getline(iss, field, ',')) {
+            fields.push_back(field);
+        }
+
+        if (fields.size() != 8 || fields[0].length() != 6 || fields[0] == "flop") {
+            continue; // Header or torn line
+        }
+
+        try {
+            FlopSummary summary;
+            for (size_t i = 0; i < 6; i += 2) {
+                summary.flop.push_back(Card::fromString(fields[0].substr(i, 2)));
+            }
+            summary.weight = std::stoi(fields[1]);
+            summary.winRate = std::stod(fields[2]);
+            summary.tieRate = std::stod(fields[3]);
+            summary.loseRate = std::stod(fields[4]);
+            summary.simulations = std::stoi(fields[6]);
+            summary.combos = std::stoi(fields[7]);
+            result.push_back(summary);
+        } catch (const std::exception&) {
+            // Skip malformed rows; the flop will be solved again
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,122 @@
+#include "../include/HandClass.h"
+#include <stdexcept>
+#include <cctype>
+
+namespace {
+
+const char RANK_CHARS[] = "23456789TJQKA";
+
+int parseRankChar(char c) {
+    char upper = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    for (int i = 0; i < 13; i++) {
+        if (RANK_CHARS[i] == upper) {
+            return i + 2;
+        }
+    }
+    throw std::invalid_argument("Invalid rank: " + std::string(1, c));
+}
+
+} // namespace
+
+HandClass::HandClass(int high, int low, bool isSuited)
+    : highRank(high), lowRank(low), suited(isSuited) {
+    if (high < low) {
+        std::swap(highRank, lowRank);
+    }
+    if (lowRank < 2 || highRank > 14) {
+        throw std::invalid_argument("Invalid hand class ranks");
+    }
+    if (highRank == lowRank) {
+        suited = false;
+    }
+}
+
+HandClass HandClass::fromString(const std::string& str) {
+    if (str.length() < 2 || str.length() > 3) {
+        throw std::invalid_argument("Invalid hand class: " + str);
+    }
+
+    int r1 = parseRankChar(str[0]);
+    int r2 = parseRankChar(str[1]);
+
+    if (r1 == r2) {
+        if (str.length() == 3) {
+            throw std::invalid_argument("Pairs take no suit qualifier: " + str);
+        }
+        return HandClass(r1, r2, false);
+    }
+
+    if (str.length() != 3) {
+        throw std::invalid_argument("Non-pair needs 's' or 'o': " + str);
+    }
+
+    char qualifier = static_cast<char>(std::tolower(static_cast<unsigned char>(str[2])));
+    if (qualifier != 's' && qualifier != 'o') {
+        throw std::invalid_argument("Invalid suit qualifier: " + str);
+    }
+
+    return HandClass(r1, r2, qualifier == 's');
+}
+
+HandClass HandClass::fromCards(const Card& c1, const Card& c2) {
+    return HandClass(c1.getRankValue(), c2.getRankValue(), c1.getSuit() == c2.getSuit());
+}
+
+HandClass HandClass::fromIndex(int index) {
+    if (index < 0 || index >= COUNT) {
+        throw std::invalid_argument("Invalid hand class index: " + std::to_string(index));
+    }
+
+    int row = index / 13;
+    int col = index % 13;
+    int rowRank = 14 - row;
+    int colRank = 14 - col;
+
+    // Suited above the diagonal, offsuit below
+    return HandClass(rowRank, colRank, row < col);
+}
+
+int HandClass::index() const {
+    int highIdx = 14 - highRank;
+    int lowIdx = 14 - lowRank;
+
+    if (suited) {
+        return highIdx * 13 + lowIdx;
+    }
+    return lowIdx * 13 + highIdx;
+}
+
+int HandClass::comboCount() const {
+    if (isPair()) return 6;
+    return suited ? 4 : 12;
+}
+
+std::vector<std::pair<Card, Card>> HandClass::combos() const {
+    std::vector<std::pair<Card, Card>> result;
+    result.reserve(comboCount());
+
+    Rank high = static_cast<Rank>(highRank);
+    Rank low = static_cast<Rank>(lowRank);
+
+    for (int s1 = 0; s1 < 4; s1++) {
+        for (int s2 = 0; s2 < 4; s2++) {
+            if (isPair() && s2 <= s1) continue;
+            if (!isPair() && suited != (s1 == s2)) continue;
+
+            result.emplace_back(Card(high, static_cast<Suit>(s1)),
+                                Card(low, static_cast<Suit>(s2)));
+        }
+    }
+
+    return result;
+}
+
+std::string HandClass::toString() const {
+    std::string result;
+    result += RANK_CHARS[highRank - 2];
+    result += RANK_CHARS[lowRank - 2];
+    if (!isPair()) {
+        result += suited ? 's' : 'o';
+    }
+    return result;
+}
@@ -1,6 +1,6 @@
 #include "../include/HandEvaluator.h"
+#include "../include/SolverStats.h"
 #include <algorithm>
-#include <map>
 #include <sstream>
 
 std::string HandValue::toString() const {
@@ -22,46 +22,32 @@ std::string HandValue::toString() const {
     return result;
 }
 
-HandValue HandEvaluator::evaluate(std::vector<Card> cards) {
+HandValue HandEvaluator::evaluate(const std::vector<Card>& cards) {
     if (cards.size() < 5) {
         throw std::invalid_argument("At least 5 cards required to evaluate a hand");
     }
     
     // Si on a exactement 5 cartes, évaluation directe
-    if (cards.size() == 5) {
-        return evaluateFiveCards(cards);
+    const int n = static_cast<int>(cards.size());
+    const Card* five[5];
+    if (n == 5) {
+        for (int i = 0; i < 5; i++) five[i] = &cards[i];
+        return evaluateFive(five);
     }
     
-    // Sinon, tester toutes les combinaisons de 5 cartes parmi les 7
+    // Sinon, tester toutes les combinaisons de 5 cartes (pointeurs sur la pile, sans allocation)
     HandValue bestHand;
-    int n = cards.size();
-    
-    // Générer toutes les combinaisons de 5 cartes
-    std::vector<int> indices(5);
-    for (int i = 0; i < 5; i++) indices[i] = i;
-    
-    do {
-        std::vector<Card> fiveCards;
-        for (int idx : indices) {
-            fiveCards.push_back(cards[idx]);
-        }
-        
-        HandValue current = evaluateFiveCards(fiveCards);
-        if (current > bestHand) {
-            bestHand = current;
-        }
-        
-    } while (std::next_permutation(indices.begin(), indices.end()) && indices[4] < n);
-    
-    // Méthode plus efficace: itération sur toutes les combinaisons
-    bestHand = HandValue();
     for (int i = 0; i < n - 4; i++) {
         for (int j = i + 1; j < n - 3; j++) {
             for (int k = j + 1; k < n - 2; k++) {
                 for (int l = k + 1; l < n - 1; l++) {
                     for (int m = l + 1; m < n; m++) {
-                        std::vector<Card> fiveCards = {cards[i], cards[j], cards[k], cards[l], cards[m]};
-                        HandValue current = evaluateFiveCards(fiveCards);
+                        five[0] = &cards[i];
+                        five[1] = &cards[j];
+                        five[2] = &cards[k];
+                        five[3] = &cards[l];
+                        five[4] = &cards[m];
+                        HandValue current = evaluateFive(five);
                         if (current > bestHand) {
                             bestHand = current;
                         }
@@ -78,150 +64,286 @@ HandValue HandEvaluator::evaluateFiveCards(const std::vector<Card>& cards) {
     if (cards.size() != 5) {
         throw std::invalid_argument("Exactly 5 cards required");
     }
-    
+    const Card* five[5] = {&cards[0], &cards[1], &cards[2], &cards[3], &cards[4]};
+    return evaluateFive(five);
+}
+
+void HandEvaluator::setHand(HandValue& hand, HandRank rank, std::initializer_list<int> kickers) {
+    hand.rank = rank;
+    hand.numKickers = 0;
+    for (int kicker : kickers) {
+        hand.kickers[hand.numKickers++] = kicker;
+    }
+    hand.score = calculateScore(rank, hand.kickers, hand.numKickers);
+}
+
+HandValue HandEvaluator::evaluateFive(const Card* const* cards) {
     HandValue result;
     
-    // Trier les cartes par rang décroissant
-    std::vector<Card> sortedCards = cards;
-    std::sort(sortedCards.begin(), sortedCards.end(), 
-              [](const Card& a, const Card& b) { return a.getRankValue() > b.getRankValue(); });
+    // Trier les cartes par rang décroissant (tri par insertion des 5 pointeurs)
+    const Card* sortedCards[5];
+    for (int i = 0; i < 5; i++) {
+        int j = i;
+        while (j > 0 && sortedCards[j - 1]->getRankValue() < cards[i]->getRankValue()) {
+            sortedCards[j] = sortedCards[j - 1];
+            j--;
+        }
+        sortedCards[j] = cards[i];
+    }
+    int ranks[5];
+    for (int i = 0; i < 5; i++) {
+        ranks[i] = sortedCards[i]->getRankValue();
+    }
     
     // Vérifier Flush
     bool isFlushHand = isFlush(sortedCards);
     
     // Vérifier Straight
     int straightHigh = 0;
-    bool isStraightHand = isStraight(sortedCards, straightHigh);
+    bool isStraightHand = isStraight(ranks, straightHigh);
     
     // Quinte Flush Royale
     if (isFlushHand && isStraightHand && straightHigh == 14) {
-        result.rank = HandRank::ROYAL_FLUSH;
-        result.kickers = {14};
-        result.score = calculateScore(result.rank, result.kickers);
+        setHand(result, HandRank::ROYAL_FLUSH, {14});
         return result;
     }
     
     // Quinte Flush
     if (isFlushHand && isStraightHand) {
-        result.rank = HandRank::STRAIGHT_FLUSH;
-        result.kickers = {straightHigh};
-        result.score = calculateScore(result.rank, result.kickers);
+        setHand(result, HandRank::STRAIGHT_FLUSH, {straightHigh});
         return result;
     }
     
-    // Compter les occurrences de chaque rang
-    std::map<int, int> rankCount;
-    for (const auto& card : sortedCards) {
-        rankCount[card.getRankValue()]++;
+    // Organiser les comptages (count, rank): rangs décroissants, puis tri stable par nombre
+    int rankCount[15] = {0};
+    for (int rank : ranks) {
+        rankCount[rank]++;
+    }
+    std::pair<int, int> counts[5];
+    int numCounts = 0;
+    for (int rank = 14; rank >= 2; rank--) {
+        if (rankCount[rank] == 0) continue;
+        int j = numCounts++;
+        while (j > 0 && counts[j - 1].first < rankCount[rank]) {
+            counts[j] = counts[j - 1];
+            j--;
+        }
+        counts[j] = {rankCount[rank], rank};
     }
-    
-    // Organiser les comptages
-    std::vector<std::pair<int, int>> counts; // (count, rank)
-    for (const auto& pair : rankCount) {
-        counts.push_back({pair.second, pair.first});
-    }
-    std::sort(counts.begin(), counts.end(), 
-              [](const auto& a, const auto& b) {
-                  if (a.first != b.first) return a.first > b.first;
-                  return a.second > b.second;
-              });
     
     // Carré
     if (counts[0].first == 4) {
-        result.rank = HandRank::FOUR_OF_A_KIND;
-        result.kickers = {counts[0].second, counts[1].second};
-        result.score = calculateScore(result.rank, result.kickers);
+        setHand(result, HandRank::FOUR_OF_A_KIND, {counts[0].second, counts[1].second});
         return result;
     }
     
     // Full
     if (counts[0].first == 3 && counts[1].first == 2) {
-        result.rank = HandRank::FULL_HOUSE;
-        result.kickers = {counts[0].second, counts[1].second};
-        result.score = calculateScore(result.rank, result.kickers);
+        setHand(result, HandRank::FULL_HOUSE, {counts[0].second, counts[1].second});
         return result;
     }
     
     // Couleur
     if (isFlushHand) {
-        result.rank = HandRank::FLUSH;
-        for (const auto& card : sortedCards) {
-            result.kickers.push_back(card.getRankValue());
-        }
-        result.score = calculateScore(result.rank, result.kickers);
+        setHand(result, HandRank::FLUSH, {ranks[0], ranks[1], ranks[2], ranks[3], ranks[4]});
         return result;
     }
     
     // Quinte
     if (isStraightHand) {
-        result.rank = HandRank::STRAIGHT;
-        result.kickers = {straightHigh};
-        result.score = calculateScore(result.rank, result.kickers);
+        setHand(result, HandRank::STRAIGHT, {straightHigh});
         return result;
     }
     
     // Brelan
     if (counts[0].first == 3) {
-        result.rank = HandRank::THREE_OF_A_KIND;
-        result.kickers = {counts[0].second, counts[1].second, counts[2].second};
-        result.score = calculateScore(result.rank, result.kickers);
+        setHand(result, HandRank::THREE_OF_A_KIND, {counts[0].second, counts[1].second, counts[2].second});
         return result;
     }
     
     // Double Paire
     if (counts[0].first == 2 && counts[1].first == 2) {
-        result.rank = HandRank::TWO_PAIR;
         int high = std::max(counts[0].second, counts[1].second);
         int low = std::min(counts[0].second, counts[1].second);
-        result.kickers = {high, low, counts[2].second};
-        result.score = calculateScore(result.rank, result.kickers);
+        setHand(result, HandRank::TWO_PAIR, {high, low, counts[2].second});
         return result;
     }
     
     // Paire
     if (counts[0].first == 2) {
-        result.rank = HandRank::PAIR;
-        result.kickers = {counts[0].second, counts[1].second, counts[2].second, counts[3].second};
-        result.score = calculateScore(result.rank, result.kickers);
+        setHand(result, HandRank::PAIR, {counts[0].second, counts[1].second, counts[2].second, counts[3].second});
         return result;
     }
     
     // Carte Haute
-    result.rank = HandRank::HIGH_CARD;
-    for (const auto& card : sortedCards) {
-        result.kickers.push_back(card.getRankValue());
-    }
-    result.score = calculateScore(result.rank, result.kickers);
-    
+    setHand(result, HandRank::HIGH_CARD, {ranks[0], ranks[1], ranks[2], ranks[3], ranks[4]});
     return result;
 }
 
+namespace {
+
+// Plus haute quinte d'un masque de rangs (bit r = rang r présent), 0 si aucune
+int straightHighCard(int rankMask) {
+    if (rankMask & (1 << 14)) {
+        rankMask |= 1 << 1; // L'As compte aussi comme carte basse (A-2-3-4-5)
+    }
+    for (int high = 14; high >= 5; high--) {
+        if (((rankMask >> (high - 4)) & 0x1F) == 0x1F) {
+            return high;
+        }
+    }
+    return 0;
+}
+
+// Mêmes poids que HandEvaluator::calculateScore
+int packScore(HandRank rank, const int* kickers, int count) {
+    static const int WEIGHTS[5] = {1000000, 10000, 100, 1, 0};
+    int score = static_cast<int>(rank) * 100000000;
+    for (int i = 0; i < count; i++) {
+        score += kickers[i] * WEIGHTS[i];
+    }
+    return score;
+}
+
+// Remplit out avec au plus 'count' rangs les plus hauts du masque, sans les rangs exclus
+int topRanks(int rankMask, int count, int* out, int excludeA = 0, int excludeB = 0) {
+    int found = 0;
+    for (int r = 14; r >= 2 && found < count; r--) {
+        if ((rankMask & (1 << r)) && r != excludeA && r != excludeB) {
+            out[found++] = r;
+        }
+    }
+    return found;
+}
+
+} // namespace
+
+void HandEvaluator::evaluateScores(const uint8_t* hands, const uint8_t* counts, int numHands, int* scores) {
+    if (Instrumentation::enabled()) {
+        Instrumentation::addEvaluations(static_cast<uint64_t>(std::max(0, numHands)));
+    }
+    for (int i = 0; i < numHands; i++) {
+        scores[i] = evaluateScore(hands + 7 * i, counts[i]);
+    }
+}
+
+int HandEvaluator::evaluateScore(const uint8_t* cardIndices, int count) {
+    if (count < 5 || count > 7) {
+        throw std::invalid_argument("Between 5 and 7 cards required to evaluate a hand");
+    }
+
+    int rankCount[15] = {0};
+    int suitMask[4] = {0};
+    int suitCount[4] = {0};
+    int rankMask = 0;
+
+    for (int i = 0; i < count; i++) {
+        int rank = cardIndices[i] % 13 + 2;
+        int suit = cardIndices[i] / 13;
+        rankCount[rank]++;
+        suitMask[suit] |= 1 << rank;
+        suitCount[suit]++;
+        rankMask |= 1 << rank;
+    }
+
+    int kickers[5] = {0};
+
+    int flushSuit = -1;
+    for (int s = 0; s < 4; s++) {
+        if (suitCount[s] >= 5) flushSuit = s;
+    }
+
+    if (flushSuit >= 0) {
+        int high = straightHighCard(suitMask[flushSuit]);
+        if (high == 14) {
+            kickers[0] = 14;
+            return packScore(HandRank::ROYAL_FLUSH, kickers, 1);
+        }
+        if (high > 0) {
+            kickers[0] = high;
+            return packScore(HandRank::STRAIGHT_FLUSH, kickers, 1);
+        }
+    }
+
+    int quads = 0, trips = 0, pairHigh = 0, pairLow = 0;
+    for (int r = 14; r >= 2; r--) {
+        if (rankCount[r] == 4) {
+            if (!quads) quads = r;
+        } else if (rankCount[r] == 3) {
+            if (!trips) trips = r;
+            else if (!pairHigh) pairHigh = r; // Le second brelan joue comme la paire
+        } else if (rankCount[r] == 2) {
+            if (!pairHigh) pairHigh = r;
+            else if (!pairLow) pairLow = r;
+        }
+    }
+
+    if (quads) {
+        kickers[0] = quads;
+        topRanks(rankMask, 1, kickers + 1, quads);
+        return packScore(HandRank::FOUR_OF_A_KIND, kickers, 2);
+    }
+
+    if (trips && pairHigh) {
+        kickers[0] = trips;
+        kickers[1] = pairHigh;
+        return packScore(HandRank::FULL_HOUSE, kickers, 2);
+    }
+
+    if (flushSuit >= 0) {
+        topRanks(suitMask[flushSuit], 5, kickers);
+        return packScore(HandRank::FLUSH, kickers, 5);
+    }
+
+    int straightHigh = straightHighCard(rankMask);
+    if (straightHigh) {
+        kickers[0] = straightHigh;
+        return packScore(HandRank::STRAIGHT, kickers, 1);
+    }
+
+    if (trips) {
+        kickers[0] = trips;
+        topRanks(rankMask, 2, kickers + 1, trips);
+        return packScore(HandRank::THREE_OF_A_KIND, kickers, 3);
+    }
+
+    if (pairHigh && pairLow) {
+        kickers[0] = pairHigh;
+        kickers[1] = pairLow;
+        topRanks(rankMask, 1, kickers + 2, pairHigh, pairLow);
+        return packScore(HandRank::TWO_PAIR, kickers, 3);
+    }
+
+    if (pairHigh) {
+        kickers[0] = pairHigh;
+        topRanks(rankMask, 3, kickers + 1, pairHigh);
+        return packScore(HandRank::PAIR, kickers, 4);
+    }
+
+    topRanks(rankMask, 5, kickers);
+    return packScore(HandRank::HIGH_CARD, kickers, 5);
+}
+
 int HandEvaluator::compareHands(const HandValue& hand1, const HandValue& hand2) {
     if (hand1.score > hand2.score) return 1;
     if (hand1.score < hand2.score) return -1;
     return 0;
 }
 
-bool HandEvaluator::isFlush(const std::vector<Card>& cards) {
-    Suit firstSuit = cards[0].getSuit();
-    for (size_t i = 1; i < cards.size(); i++) {
-        if (cards[i].getSuit() != firstSuit) {
+bool HandEvaluator::isFlush(const Card* const* cards) {
+    Suit firstSuit = cards[0]->getSuit();
+    for (int i = 1; i < 5; i++) {
+        if (cards[i]->getSuit() != firstSuit) {
             return false;
         }
     }
     return true;
 }
 
-bool HandEvaluator::isStraight(const std::vector<Card>& cards, int& highCard) {
-    std::vector<int> ranks;
-    for (const auto& card : cards) {
-        ranks.push_back(card.getRankValue());
-    }
-    std::sort(ranks.begin(), ranks.end(), std::greater<int>());
-    
-    // Vérifier suite normale
+bool HandEvaluator::isStraight(const int* ranks, int& highCard) {
+    // Vérifier suite normale (rangs déjà triés par ordre décroissant)
     bool isStraightNormal = true;
-    for (size_t i = 0; i < ranks.size() - 1; i++) {
+    for (int i = 0; i < 4; i++) {
         if (ranks[i] - ranks[i + 1] != 1) {
             isStraightNormal = false;
             break;
@@ -242,13 +364,13 @@ bool HandEvaluator::isStraight(const std::vector<Card>& cards, int& highCard) {
     return false;
 }
 
-int HandEvaluator::calculateScore(HandRank rank, const std::vector<int>& kickers) {
+int HandEvaluator::calculateScore(HandRank rank, const int* kickers, int count) {
     int score = static_cast<int>(rank) * 100000000; // Base sur le rang de la main
     
     // Ajouter les kickers avec poids décroissants
     int multiplier = 1000000;
-    for (int kicker : kickers) {
-        score += kicker * multiplier;
+    for (int i = 0; i < count; i++) {
+        score += kickers[i] * multiplier;
         multiplier /= 100;
     }
     
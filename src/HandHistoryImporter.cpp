@@ -0,0 +1,545 @@
+#include "../include/HandHistoryImporter.h"
+#include "HandLog.h"
+#include "Card.h"
+#include "PokerGame.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    typedef std::unordered_map<uint64_t, std::string> NameTable;
+
+    template <size_t N>
+    inline bool startsWith(const char* p, const char* end, const char (&literal)[N]) {
+        return static_cast<size_t>(end - p) >= N - 1 && std::memcmp(p, literal, N - 1) == 0;
+    }
+
+    template <size_t N>
+    const char* find(const char* p, const char* end, const char (&literal)[N]) {
+        const size_t length = N - 1;
+        while (static_cast<size_t>(end - p) >= length) {
+            const char* hit = static_cast<const char*>(std::memchr(p, literal[0], end - p - length + 1));
+            if (!hit) return nullptr;
+            if (std::memcmp(hit, literal, length) == 0) return hit;
+            p = hit + 1;
+        }
+        return nullptr;
+    }
+
+    inline bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    inline uint64_t parseNumber(const char*& p, const char* end) {
+        uint64_t value = 0;
+        while (p < end && isDigit(*p)) {
+            value = value * 10 + static_cast<uint64_t>(*p++ - '0');
+        }
+        return value;
+    }
+
+    // Montant "$1,234.56", "€0.5" ou "1500": centimes en cash, jetons en tournoi
+    bool parseAmount(const char*& p, const char* end, bool cents, int32_t& amount) {
+        while (p < end && (*p == '$' || static_cast<unsigned char>(*p) >= 0x80)) p++;
+        if (p >= end || !isDigit(*p)) return false;
+
+        int64_t whole = 0;
+        while (p < end && (isDigit(*p) || (*p == ',' && p + 1 < end && isDigit(p[1])))) {
+            if (*p != ',') whole = whole * 10 + (*p - '0');
+            p++;
+        }
+
+        int64_t fraction = 0;
+        if (p + 1 < end && *p == '.' && isDigit(p[1])) {
+            p++;
+            int digits = 0;
+            while (p < end && isDigit(*p)) {
+                if (digits < 2) fraction = fraction * 10 + (*p - '0');
+                digits++;
+                p++;
+            }
+            if (digits == 1) fraction *= 10;
+        }
+
+        amount = static_cast<int32_t>(cents ? whole * 100 + fraction : whole);
+        return true;
+    }
+
+    // Cartes entre crochets "[Ah Kd]", renvoie le nombre lu ou -1
+    int parseCards(const char* p, const char* end, uint8_t* cards, int maxCards) {
+        if (p >= end || *p != '[') return -1;
+        p++;
+        int count = 0;
+        while (true) {
+            while (p < end && *p == ' ') p++;
+            if (p >= end) return -1;
+            if (*p == ']') return count;
+            if (end - p < 2 || count == maxCards) return -1;
+            int index = Card::parseIndex(p);
+            if (index < 0) return -1;
+            cards[count++] = static_cast<uint8_t>(index);
+            p += 2;
+        }
+    }
+
+    int64_t daysFromCivil(int year, int month, int day) {
+        year -= month <= 2;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const int64_t yearOfEra = year - era * 400;
+        const int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    // Première date "AAAA/MM/JJ H:MM:SS" de la ligne
+    int64_t parseTimestamp(const char* p, const char* end) {
+        for (; end - p >= 10; p++) {
+            if (!(isDigit(p[0]) && isDigit(p[1]) && isDigit(p[2]) && isDigit(p[3]) && p[4] == '/' &&
+                  isDigit(p[5]) && isDigit(p[6]) && p[7] == '/' && isDigit(p[8]) && isDigit(p[9]))) {
+                continue;
+            }
+            const char* q = p;
+            int year = static_cast<int>(parseNumber(q, end));
+            q++;
+            int month = static_cast<int>(parseNumber(q, end));
+            q++;
+            int day = static_cast<int>(parseNumber(q, end));
+            int64_t seconds = daysFromCivil(year, month, day) * 86400;
+
+            if (q < end && *q == ' ') {
+                q++;
+                int64_t clock[3] = {0, 0, 0};
+                for (int i = 0; i < 3 && q < end && isDigit(*q); i++) {
+                    clock[i] = static_cast<int64_t>(parseNumber(q, end));
+                    if (q < end && *q == ':') q++;
+                }
+                seconds += clock[0] * 3600 + clock[1] * 60 + clock[2];
+            }
+            return seconds;
+        }
+        return 0;
+    }
+
+    struct SeatNames {
+        const char* text[HandRecord::MAX_SEATS];
+        size_t length[HandRecord::MAX_SEATS];
+        int count = 0;
+
+        // Joueur dont le nom commence la ligne, suivi de separator (le plus long gagne)
+        int match(const char* p, const char* end, const char* separator, size_t separatorLength) const {
+            int best = -1;
+            for (int s = 0; s < count; s++) {
+                const size_t n = length[s];
+                if (static_cast<size_t>(end - p) < n + separatorLength) continue;
+                if (std::memcmp(p, text[s], n) != 0 || std::memcmp(p + n, separator, separatorLength) != 0) continue;
+                if (best < 0 || n > length[best]) best = s;
+            }
+            return best;
+        }
+
+        int matchExact(const char* p, const char* end) const {
+            for (int s = 0; s < count; s++) {
+                if (static_cast<size_t>(end - p) == length[s] && std::memcmp(p, text[s], length[s]) == 0) return s;
+            }
+            return -1;
+        }
+    };
+}
+
+HandHistoryImporter::HandHistoryImporter(int numThreads, size_t segmentBytes)
+    : threads(numThreads), segmentSize(std::max<size_t>(segmentBytes, 4096)) {
+}
+
+const char* HandHistoryImporter::findHandStart(const char* from, const char* fileBegin, const char* end) {
+    const char* p = from;
+    while ((p = find(p, end, "PokerStars ")) != nullptr) {
+        // En début de ligne (ou après le BOM UTF-8 du fichier)
+        if (p == fileBegin || p[-1] == '\n' ||
+            (p - fileBegin == 3 && std::memcmp(fileBegin, "\xEF\xBB\xBF", 3) == 0)) {
+            return p;
+        }
+        p++;
+    }
+    return end;
+}
+
+bool HandHistoryImporter::parseHand(const char* begin, const char* end, HandRecord& record, NameTable* names) {
+    record.clear();
+
+    const char* next = begin;
+    const char* line = nullptr;
+    const char* lineEnd = nullptr;
+    auto nextLine = [&]() {
+        if (next >= end) return false;
+        line = next;
+        const char* newline = static_cast<const char*>(std::memchr(next, '\n', end - next));
+        lineEnd = newline ? newline : end;
+        next = newline ? newline + 1 : end;
+        if (lineEnd > line && lineEnd[-1] == '\r') lineEnd--;
+        return true;
+    };
+
+    // En-tête: numéro de main, tournoi, blindes et date
+    if (!nextLine() || !startsWith(line, lineEnd, "PokerStars ")) return false;
+    const char* id = find(line, lineEnd, "Hand #");
+    if (!id) id = find(line, lineEnd, "Game #");
+    if (!id || !find(line, lineEnd, "Hold'em")) return false;
+    id += 6;
+    record.handId = parseNumber(id, lineEnd);
+
+    const char* tournament = find(line, lineEnd, "Tournament #");
+    bool cents = true;
+    if (tournament) {
+        tournament += 12;
+        record.tournamentId = parseNumber(tournament, lineEnd);
+        record.flags |= HandRecord::TOURNAMENT;
+        cents = false;
+    }
+
+    const char* blinds = id;
+    while ((blinds = static_cast<const char*>(std::memchr(blinds, '(', lineEnd - blinds))) != nullptr) {
+        const char* q = ++blinds;
+        int32_t small, big;
+        if (parseAmount(q, lineEnd, cents, small) && q < lineEnd && *q == '/' &&
+            parseAmount(++q, lineEnd, cents, big)) {
+            record.smallBlind = small;
+            record.bigBlind = big;
+            break;
+        }
+    }
+    if (!blinds) return false;
+    record.timestamp = parseTimestamp(blinds, lineEnd);
+
+    // Table et bouton
+    if (!nextLine() || !startsWith(line, lineEnd, "Table '")) return false;
+    const char* tableName = line + 7;
+    const char* tableEnd = find(tableName, lineEnd, "' ");
+    if (!tableEnd) return false;
+    record.tableId = HandRecord::playerId(tableName, static_cast<size_t>(tableEnd - tableName));
+
+    int buttonSeatNumber = -1;
+    const char* button = find(tableEnd, lineEnd, "Seat #");
+    if (button) {
+        button += 6;
+        buttonSeatNumber = static_cast<int>(parseNumber(button, lineEnd));
+    }
+
+    SeatNames seatNames;
+    int32_t streetBet[HandRecord::MAX_SEATS] = {0};
+    int street = static_cast<int>(GamePhase::PRE_FLOP);
+    enum { SEATS, ACTIONS, SUMMARY } section = SEATS;
+
+    while (nextLine()) {
+        if (section == SEATS) {
+            if (startsWith(line, lineEnd, "Seat ") && line + 5 < lineEnd && isDigit(line[5])) {
+                // "Seat 3: nom (1500 in chips)" - le nom peut contenir des espaces et parenthèses
+                const char* q = line + 5;
+                int seatNumber = static_cast<int>(parseNumber(q, lineEnd));
+                if (!startsWith(q, lineEnd, ": ")) return false;
+                const char* name = q + 2;
+                const char* chips = find(name, lineEnd, " in chips");
+                if (!chips) return false;
+                const char* open = chips;
+                while (open > name && *open != '(') open--;
+                if (open - name < 2 || open[-1] != ' ') return false;
+                if (find(chips, lineEnd, " is sitting out") || find(chips, lineEnd, " out of hand")) continue;
+                if (record.numSeats == HandRecord::MAX_SEATS) return false;
+
+                const char* stackText = open + 1;
+                HistorySeat& seat = record.seats[record.numSeats];
+                if (!parseAmount(stackText, chips, cents, seat.stack)) return false;
+                const size_t nameLength = static_cast<size_t>(open - 1 - name);
+                seat.playerId = HandRecord::playerId(name, nameLength);
+                seat.invested = 0;
+                seat.collected = 0;
+                seat.seatNumber = static_cast<uint8_t>(seatNumber);
+                seat.cards[0] = seat.cards[1] = HandRecord::NO_CARD;
+                seat.flags = 0;
+                if (seatNumber == buttonSeatNumber) record.button = record.numSeats;
+
+                seatNames.text[seatNames.count] = name;
+                seatNames.length[seatNames.count] = nameLength;
+                seatNames.count++;
+                record.numSeats++;
+
+                if (names && names->find(seat.playerId) == names->end()) {
+                    names->emplace(seat.playerId, std::string(name, nameLength));
+                }
+                continue;
+            }
+            if (record.numSeats < 2) return false;
+            section = ACTIONS;
+        }
+
+        if (section == SUMMARY) {
+            if (startsWith(line, lineEnd, "Board [")) {
+                int count = parseCards(line + 6, lineEnd, record.board, 5);
+                if (count < 0) return false;
+                record.boardCount = static_cast<uint8_t>(count);
+            } else if (startsWith(line, lineEnd, "Seat ")) {
+                const char* shown = find(line, lineEnd, "showed [");
+                if (!shown) shown = find(line, lineEnd, "mucked [");
+                if (!shown) continue;
+                const char* q = line + 5;
+                int seatNumber = static_cast<int>(parseNumber(q, lineEnd));
+                for (int s = 0; s < record.numSeats; s++) {
+                    HistorySeat& seat = record.seats[s];
+                    if (seat.seatNumber != seatNumber) continue;
+                    if (parseCards(shown + 7, lineEnd, seat.cards, 2) == 2) seat.flags |= HistorySeat::SHOWED;
+                    break;
+                }
+            }
+            continue;
+        }
+
+        // Section des actions
+        if (startsWith(line, lineEnd, "*** ")) {
+            const char* marker = line + 4;
+            int boardCards = -1;
+            if (startsWith(marker, lineEnd, "HOLE CARDS")) {
+                street = static_cast<int>(GamePhase::PRE_FLOP);
+            } else if (startsWith(marker, lineEnd, "FLOP")) {
+                street = static_cast<int>(GamePhase::FLOP);
+                boardCards = 3;
+            } else if (startsWith(marker, lineEnd, "TURN")) {
+                street = static_cast<int>(GamePhase::TURN);
+                boardCards = 4;
+            } else if (startsWith(marker, lineEnd, "RIVER")) {
+                street = static_cast<int>(GamePhase::RIVER);
+                boardCards = 5;
+            } else if (startsWith(marker, lineEnd, "SUMMARY")) {
+                section = SUMMARY;
+            } else if (startsWith(marker, lineEnd, "FIRST") || startsWith(marker, lineEnd, "SECOND")) {
+                return false; // Tableau tiré deux fois: non pris en charge
+            }
+
+            if (boardCards > 0) {
+                // La dernière paire de crochets contient la ou les nouvelles cartes
+                const char* bracket = lineEnd;
+                while (bracket > marker && *bracket != '[') bracket--;
+                const int dealt = boardCards == 3 ? 3 : 1;
+                if (parseCards(bracket, lineEnd, record.board + boardCards - dealt, dealt) != dealt) return false;
+                record.boardCount = static_cast<uint8_t>(boardCards);
+                std::fill(streetBet, streetBet + HandRecord::MAX_SEATS, 0);
+            }
+            continue;
+        }
+
+        if (startsWith(line, lineEnd, "Dealt to ")) {
+            const char* name = line + 9;
+            int s = seatNames.match(name, lineEnd, " [", 2);
+            if (s >= 0 && parseCards(name + seatNames.length[s] + 1, lineEnd, record.seats[s].cards, 2) == 2) {
+                record.seats[s].flags |= HistorySeat::HERO;
+            }
+            continue;
+        }
+
+        HistoryAction action;
+        action.street = static_cast<uint8_t>(street);
+        action.allIn = false;
+        action.amount = 0;
+
+        if (startsWith(line, lineEnd, "Uncalled bet (")) {
+            const char* q = line + 14;
+            const char* returned = find(q, lineEnd, ") returned to ");
+            if (!returned || !parseAmount(q, returned, cents, action.amount)) return false;
+            int s = seatNames.matchExact(returned + 14, lineEnd);
+            if (s < 0) return false;
+            action.seat = static_cast<uint8_t>(s);
+            action.type = HistoryActionType::UNCALLED;
+            record.seats[s].invested -= action.amount;
+        } else {
+            int s = seatNames.match(line, lineEnd, ": ", 2);
+            if (s < 0) {
+                // "nom collected $1.20 from pot" (pot principal ou secondaire)
+                s = seatNames.match(line, lineEnd, " collected ", 11);
+                if (s >= 0) {
+                    const char* q = line + seatNames.length[s] + 11;
+                    int32_t amount;
+                    if (parseAmount(q, lineEnd, cents, amount)) record.seats[s].collected += amount;
+                }
+                continue; // Autres lignes: discussion, connexions...
+            }
+
+            const char* q = line + seatNames.length[s] + 2;
+            HistorySeat& seat = record.seats[s];
+            action.seat = static_cast<uint8_t>(s);
+            action.allIn = find(q, lineEnd, "and is all-in") != nullptr;
+
+            if (startsWith(q, lineEnd, "folds")) {
+                action.type = HistoryActionType::FOLD;
+                seat.flags |= HistorySeat::FOLDED;
+            } else if (startsWith(q, lineEnd, "checks")) {
+                action.type = HistoryActionType::CHECK;
+            } else if (startsWith(q, lineEnd, "calls ")) {
+                action.type = HistoryActionType::CALL;
+                q += 6;
+                if (!parseAmount(q, lineEnd, cents, action.amount)) return false;
+                streetBet[s] += action.amount;
+            } else if (startsWith(q, lineEnd, "bets ")) {
+                action.type = HistoryActionType::BET;
+                q += 5;
+                if (!parseAmount(q, lineEnd, cents, action.amount)) return false;
+                streetBet[s] += action.amount;
+            } else if (startsWith(q, lineEnd, "raises ")) {
+                // "raises X to Y": Y est la mise totale du tour
+                action.type = HistoryActionType::RAISE;
+                const char* to = find(q, lineEnd, " to ");
+                int32_t total;
+                if (!to) return false;
+                to += 4;
+                if (!parseAmount(to, lineEnd, cents, total)) return false;
+                action.amount = total - streetBet[s];
+                streetBet[s] = total;
+            } else if (startsWith(q, lineEnd, "posts ")) {
+                q += 6;
+                if (startsWith(q, lineEnd, "small blind ")) {
+                    action.type = HistoryActionType::POST_SMALL_BLIND;
+                    q += 12;
+                } else if (startsWith(q, lineEnd, "big blind ")) {
+                    action.type = HistoryActionType::POST_BIG_BLIND;
+                    q += 10;
+                } else if (startsWith(q, lineEnd, "the ante ")) {
+                    action.type = HistoryActionType::POST_ANTE;
+                    q += 9;
+                } else {
+                    action.type = HistoryActionType::POST_BLIND;
+                    while (q < lineEnd && !isDigit(*q) && *q != '$' && static_cast<unsigned char>(*q) < 0x80) q++;
+                }
+                if (!parseAmount(q, lineEnd, cents, action.amount)) return false;
+                if (action.type == HistoryActionType::POST_ANTE) {
+                    record.ante = std::max(record.ante, action.amount);
+                } else if (action.type == HistoryActionType::POST_BLIND) {
+                    streetBet[s] += std::min(action.amount, record.bigBlind); // La petite blinde est morte
+                } else {
+                    streetBet[s] += action.amount;
+                }
+            } else if (startsWith(q, lineEnd, "shows [")) {
+                if (parseCards(q + 6, lineEnd, seat.cards, 2) == 2) seat.flags |= HistorySeat::SHOWED;
+                continue;
+            } else {
+                continue; // "mucks hand", "doesn't show hand", "is sitting out"...
+            }
+
+            seat.invested += action.amount;
+            if (action.allIn) seat.flags |= HistorySeat::ALL_IN;
+        }
+
+        if (record.numActions == HandRecord::MAX_ACTIONS) return false;
+        record.actions[record.numActions++] = action;
+    }
+
+    return section != SEATS && record.bigBlind > 0;
+}
+
+ImportStats HandHistoryImporter::importFile(const std::string& historyPath, const std::string& outputPath,
+                                            const std::function<void(long long, long long)>& progress) const {
+    auto start = std::chrono::steady_clock::now();
+
+    MappedFile file(historyPath);
+
+    // ".phl": journal compressé (HandLog), sinon fichier d'enregistrements
+    const bool handLog = outputPath.size() >= 4 && outputPath.compare(outputPath.size() - 4, 4, ".phl") == 0;
+    std::unique_ptr<HandRecordWriter> recordWriter;
+    std::unique_ptr<HandLogWriter> logWriter;
+    if (handLog) {
+        logWriter.reset(new HandLogWriter(outputPath));
+    } else {
+        recordWriter.reset(new HandRecordWriter(outputPath));
+    }
+    HandRecord logRecord;
+    const char* fileBegin = file.data();
+    const char* fileEnd = fileBegin + file.size();
+
+    const size_t numSegments = (file.size() + segmentSize - 1) / segmentSize;
+    int numThreads = threads > 0 ? threads : static_cast<int>(std::thread::hardware_concurrency());
+    numThreads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(std::max(1, numThreads), numSegments)));
+
+    // État réutilisé par chaque thread d'une vague à l'autre
+    struct Worker {
+        std::vector<uint8_t> buffer;
+        size_t used = 0;
+        long long hands = 0;
+        long long skipped = 0;
+        NameTable names;
+        HandRecord record;
+    };
+    std::vector<Worker> workers(numThreads);
+
+    auto parseSegment = [&](Worker& worker, size_t segment) {
+        const char* segmentBegin = fileBegin + segment * segmentSize;
+        const char* segmentEnd = std::min(fileEnd, segmentBegin + segmentSize);
+        worker.used = 0;
+        worker.hands = 0;
+
+        const char* hand = findHandStart(segmentBegin, fileBegin, fileEnd);
+        while (hand < segmentEnd) {
+            const char* nextHand = findHandStart(hand + 1, fileBegin, fileEnd);
+            if (parseHand(hand, nextHand, worker.record, &worker.names)) {
+                if (worker.buffer.size() < worker.used + HandRecord::MAX_SERIALIZED_SIZE) {
+                    worker.buffer.resize(std::max(worker.buffer.size() * 2,
+                                                  worker.used + HandRecord::MAX_SERIALIZED_SIZE));
+                }
+                worker.used += worker.record.serialize(worker.buffer.data() + worker.used);
+                worker.hands++;
+            } else {
+                worker.skipped++;
+            }
+            hand = nextHand;
+        }
+    };
+
+    ImportStats stats;
+    stats.bytes = static_cast<long long>(file.size());
+
+    // Chaque vague traite un segment par thread, écrits ensuite dans l'ordre du fichier
+    for (size_t wave = 0; wave < numSegments; wave += numThreads) {
+        const int active = static_cast<int>(std::min<size_t>(numThreads, numSegments - wave));
+        std::vector<std::thread> pool;
+        for (int w = 1; w < active; w++) {
+            pool.emplace_back(parseSegment, std::ref(workers[w]), wave + w);
+        }
+        parseSegment(workers[0], wave);
+        for (auto& thread : pool) {
+            thread.join();
+        }
+
+        for (int w = 0; w < active; w++) {
+            const Worker& worker = workers[w];
+            if (logWriter) {
+                for (size_t at = 0; at < worker.used;) {
+                    at += HandRecord::deserialize(worker.buffer.data() + at, worker.used - at, logRecord);
+                    logWriter->write(logRecord);
+                }
+            } else {
+                recordWriter->writeSerialized(worker.buffer.data(), worker.used, worker.hands);
+            }
+            stats.hands += worker.hands;
+        }
+        if (progress) {
+            progress(static_cast<long long>(std::min(file.size(), (wave + active) * segmentSize)), stats.bytes);
+        }
+    }
+
+    NameTable names;
+    for (auto& worker : workers) {
+        stats.skipped += worker.skipped;
+        if (names.empty()) {
+            names.swap(worker.names);
+        } else {
+            names.insert(worker.names.begin(), worker.names.end());
+        }
+    }
+    if (logWriter) {
+        logWriter->finish(names);
+    } else {
+        recordWriter->finish(names);
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
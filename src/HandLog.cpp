@@ -0,0 +1,516 @@
+#include "../include/HandLog.h"
+#include "BinaryIO.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using BinaryIO::put;
+using BinaryIO::get;
+using BinaryIO::putVarint;
+using BinaryIO::zigzag;
+using BinaryIO::unzigzag;
+
+namespace {
+    const char MAGIC[4] = {'P', 'S', 'H', 'L'};
+    const size_t FILE_HEADER_SIZE = 8;
+    const size_t FOOTER_SIZE = 40;
+    const size_t BLOCK_INFO_SIZE = 24;
+    const size_t MAX_ENCODED_SIZE = 2048; // Une main encodée, longueur comprise
+
+    // Compression LZ77 par octets (format proche de LZ4: jeton, littéraux, décalage 16 bits)
+    const int HASH_BITS = 12;
+    const size_t MIN_MATCH = 4;
+    const size_t LAST_LITERALS = 5;  // Les derniers octets restent toujours des littéraux
+    const size_t MATCH_LIMIT = 12;   // Pas de correspondance commençant aussi près de la fin
+
+    inline uint32_t read32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    size_t compressBound(size_t size) {
+        return size + size / 255 + 16;
+    }
+
+    inline uint8_t* writeLength(uint8_t* out, size_t extra) {
+        while (extra >= 255) {
+            *out++ = 255;
+            extra -= 255;
+        }
+        *out++ = static_cast<uint8_t>(extra);
+        return out;
+    }
+
+    size_t lzCompress(const uint8_t* src, size_t size, uint8_t* dst) {
+        int32_t table[1 << HASH_BITS];
+        std::fill(table, table + (1 << HASH_BITS), -1);
+
+        uint8_t* out = dst;
+        size_t anchor = 0;
+        size_t i = 0;
+
+        if (size >= MATCH_LIMIT) {
+            const size_t limit = size - MATCH_LIMIT;
+            while (i <= limit) {
+                const uint32_t sequence = read32(src + i);
+                const uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+                const int32_t candidate = table[hash];
+                table[hash] = static_cast<int32_t>(i);
+                if (candidate < 0 || i - candidate > 65535 || read32(src + candidate) != sequence) {
+                    i++;
+                    continue;
+                }
+
+                size_t length = MIN_MATCH;
+                const size_t maxLength = size - LAST_LITERALS - i;
+                while (length < maxLength && src[candidate + length] == src[i + length]) length++;
+
+                const size_t literals = i - anchor;
+                const size_t offset = i - candidate;
+                *out++ = static_cast<uint8_t>((std::min<size_t>(literals, 15) << 4) |
+                                              std::min<size_t>(length - MIN_MATCH, 15));
+                if (literals >= 15) out = writeLength(out, literals - 15);
+                std::memcpy(out, src + anchor, literals);
+                out += literals;
+                *out++ = static_cast<uint8_t>(offset & 0xFF);
+                *out++ = static_cast<uint8_t>(offset >> 8);
+                if (length - MIN_MATCH >= 15) out = writeLength(out, length - MIN_MATCH - 15);
+
+                i += length;
+                anchor = i;
+            }
+        }
+
+        // Dernière séquence: littéraux seuls
+        const size_t literals = size - anchor;
+        *out++ = static_cast<uint8_t>(std::min<size_t>(literals, 15) << 4);
+        if (literals >= 15) out = writeLength(out, literals - 15);
+        std::memcpy(out, src + anchor, literals);
+        out += literals;
+        return static_cast<size_t>(out - dst);
+    }
+
+    bool lzDecompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize) {
+        const uint8_t* end = src + size;
+        uint8_t* out = dst;
+        uint8_t* outEnd = dst + rawSize;
+
+        auto readLength = [&](size_t& length) {
+            uint8_t byte;
+            do {
+                if (src >= end) return false;
+                byte = *src++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        };
+
+        while (src < end) {
+            const uint8_t token = *src++;
+            size_t literals = token >> 4;
+            if (literals == 15 && !readLength(literals)) return false;
+            if (static_cast<size_t>(end - src) < literals || static_cast<size_t>(outEnd - out) < literals) return false;
+            std::memcpy(out, src, literals);
+            out += literals;
+            src += literals;
+            if (src == end) break;
+
+            if (end - src < 2) return false;
+            const size_t offset = src[0] | (src[1] << 8);
+            src += 2;
+            size_t length = token & 15;
+            if (length == 15 && !readLength(length)) return false;
+            length += MIN_MATCH;
+            if (offset == 0 || offset > static_cast<size_t>(out - dst) ||
+                static_cast<size_t>(outEnd - out) < length) {
+                return false;
+            }
+
+            // Copie octet par octet: la source peut chevaucher la destination
+            const uint8_t* match = out - offset;
+            for (size_t k = 0; k < length; k++) {
+                out[k] = match[k];
+            }
+            out += length;
+        }
+        return out == outEnd;
+    }
+
+    inline const uint8_t* readVarint(const uint8_t* in, const uint8_t* end, uint64_t& value) {
+        const uint8_t* next = BinaryIO::getVarint(in, end, value);
+        if (!next) {
+            throw std::runtime_error("Corrupt hand log record");
+        }
+        return next;
+    }
+
+    inline const uint8_t* readSigned(const uint8_t* in, const uint8_t* end, int32_t& value) {
+        uint64_t bits;
+        in = readVarint(in, end, bits);
+        value = static_cast<int32_t>(unzigzag(bits));
+        return in;
+    }
+
+    inline bool hasAmount(HistoryActionType type) {
+        return type != HistoryActionType::FOLD && type != HistoryActionType::CHECK;
+    }
+}
+
+void HandLogEntry::decodeSeats(HistorySeat* seats, uint32_t* playerIndices) const {
+    const uint8_t* p = seatData;
+    for (int s = 0; s < numSeats; s++) {
+        HistorySeat& seat = seats[s];
+        uint64_t index;
+        p = readVarint(p, actionData, index);
+        if (index >= log->getNumPlayers()) {
+            throw std::runtime_error("Corrupt hand log record");
+        }
+        seat.playerId = log->getPlayerId(static_cast<uint32_t>(index));
+        if (playerIndices) playerIndices[s] = static_cast<uint32_t>(index);
+
+        p = readSigned(p, actionData, seat.stack);
+        p = readSigned(p, actionData, seat.invested);
+        p = readSigned(p, actionData, seat.collected);
+        if (actionData - p < 4) {
+            throw std::runtime_error("Corrupt hand log record");
+        }
+        seat.seatNumber = *p++;
+        seat.cards[0] = *p++;
+        seat.cards[1] = *p++;
+        seat.flags = *p++;
+    }
+}
+
+void HandLogEntry::decodeActions(HistoryAction* actions) const {
+    const uint8_t* p = actionData;
+    for (int a = 0; a < numActions; a++) {
+        HistoryAction& action = actions[a];
+        if (end - p < 2) {
+            throw std::runtime_error("Corrupt hand log record");
+        }
+        const uint8_t packed = *p++;
+        action.type = static_cast<HistoryActionType>(packed & 0x0F);
+        action.street = static_cast<uint8_t>((packed >> 4) & 0x03);
+        action.allIn = (packed & 0x40) != 0;
+        action.seat = *p++;
+        action.amount = 0;
+        if (hasAmount(action.type)) {
+            p = readSigned(p, end, action.amount);
+        }
+    }
+}
+
+void HandLogEntry::toRecord(HandRecord& record) const {
+    record.handId = handId;
+    record.tournamentId = tournamentId;
+    record.timestamp = timestamp;
+    record.tableId = tableId;
+    record.smallBlind = smallBlind;
+    record.bigBlind = bigBlind;
+    record.ante = ante;
+    record.flags = flags;
+    record.numSeats = numSeats;
+    record.button = button;
+    record.boardCount = boardCount;
+    std::copy(board, board + 5, record.board);
+    record.numActions = numActions;
+    decodeSeats(record.seats);
+    decodeActions(record.actions);
+}
+
+HandLogWriter::HandLogWriter(const std::string& path, size_t blockBytes)
+    : out(path, std::ios::binary | std::ios::trunc), blockSize(std::max<size_t>(blockBytes, 4096)),
+      used(0), blockRecords(0), previousHandId(0), previousTimestamp(0), offset(0), count(0) {
+    if (!out) {
+        throw std::runtime_error("Cannot create " + path);
+    }
+    block.resize(blockSize + MAX_ENCODED_SIZE);
+    compressed.resize(compressBound(block.size()));
+
+    uint8_t header[FILE_HEADER_SIZE];
+    std::memcpy(header, MAGIC, 4);
+    put(header + 4, VERSION);
+    out.write(reinterpret_cast<const char*>(header), FILE_HEADER_SIZE);
+    offset = FILE_HEADER_SIZE;
+}
+
+void HandLogWriter::write(const HandRecord& record) {
+    uint8_t* start = block.data() + used;
+    uint8_t* p = start + 2; // Longueur écrite à la fin
+
+    p = putVarint(p, zigzag(static_cast<int64_t>(record.handId - previousHandId)));
+    p = putVarint(p, record.tournamentId);
+    p = putVarint(p, zigzag(record.timestamp - previousTimestamp));
+    p = putVarint(p, record.tableId);
+    p = putVarint(p, zigzag(record.smallBlind));
+    p = putVarint(p, zigzag(record.bigBlind));
+    p = putVarint(p, zigzag(record.ante));
+    *p++ = record.flags;
+    *p++ = record.numSeats;
+    *p++ = record.button;
+    *p++ = record.boardCount;
+    *p++ = record.numActions;
+    for (int i = 0; i < record.boardCount; i++) {
+        *p++ = record.board[i];
+    }
+
+    // Sièges précédés de leur taille, pour que les lecteurs puissent les sauter
+    uint8_t seats[HandRecord::MAX_SEATS * 24];
+    uint8_t* s = seats;
+    for (int i = 0; i < record.numSeats; i++) {
+        const HistorySeat& seat = record.seats[i];
+        auto found = playerIndex.find(seat.playerId);
+        uint32_t index;
+        if (found == playerIndex.end()) {
+            index = static_cast<uint32_t>(players.size());
+            playerIndex.emplace(seat.playerId, index);
+            players.push_back(seat.playerId);
+        } else {
+            index = found->second;
+        }
+        s = putVarint(s, index);
+        s = putVarint(s, zigzag(seat.stack));
+        s = putVarint(s, zigzag(seat.invested));
+        s = putVarint(s, zigzag(seat.collected));
+        *s++ = seat.seatNumber;
+        *s++ = seat.cards[0];
+        *s++ = seat.cards[1];
+        *s++ = seat.flags;
+    }
+    p = putVarint(p, static_cast<uint64_t>(s - seats));
+    std::memcpy(p, seats, s - seats);
+    p += s - seats;
+
+    for (int a = 0; a < record.numActions; a++) {
+        const HistoryAction& action = record.actions[a];
+        *p++ = static_cast<uint8_t>(static_cast<uint8_t>(action.type) | ((action.street & 0x03) << 4) |
+                                    (action.allIn ? 0x40 : 0));
+        *p++ = action.seat;
+        if (hasAmount(action.type)) {
+            p = putVarint(p, zigzag(action.amount));
+        }
+    }
+
+    put(start, static_cast<uint16_t>(p - start - 2));
+    used += static_cast<size_t>(p - start);
+    previousHandId = record.handId;
+    previousTimestamp = record.timestamp;
+    blockRecords++;
+    count++;
+
+    if (used >= blockSize) {
+        flushBlock();
+    }
+}
+
+void HandLogWriter::flushBlock() {
+    if (blockRecords == 0) return;
+    TraceSpan span("hand log block", "checkpoint", static_cast<int64_t>(used));
+
+    const size_t size = lzCompress(block.data(), used, compressed.data());
+    const bool useCompressed = size < used;
+    const uint8_t* data = useCompressed ? compressed.data() : block.data();
+    const size_t stored = useCompressed ? size : used;
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(stored));
+
+    blocks.push_back({offset, static_cast<uint32_t>(stored), static_cast<uint32_t>(used), blockRecords,
+                      useCompressed ? 1u : 0u});
+    offset += stored;
+    used = 0;
+    blockRecords = 0;
+    previousHandId = 0;
+    previousTimestamp = 0;
+}
+
+void HandLogWriter::finish(const std::unordered_map<uint64_t, std::string>& names) {
+    flushBlock();
+
+    // Index des blocs
+    const uint64_t indexOffset = offset;
+    uint8_t entry[BLOCK_INFO_SIZE];
+    for (const auto& info : blocks) {
+        put(put(put(put(put(entry, info.offset), info.storedSize), info.rawSize), info.records), info.compressed);
+        out.write(reinterpret_cast<const char*>(entry), BLOCK_INFO_SIZE);
+        offset += BLOCK_INFO_SIZE;
+    }
+
+    // Table des joueurs puis noms connus
+    const uint64_t playersOffset = offset;
+    put(entry, static_cast<uint32_t>(players.size()));
+    out.write(reinterpret_cast<const char*>(entry), 4);
+    for (uint64_t id : players) {
+        put(entry, id);
+        out.write(reinterpret_cast<const char*>(entry), 8);
+    }
+
+    uint32_t numNames = 0;
+    for (uint64_t id : players) {
+        numNames += names.count(id) ? 1 : 0;
+    }
+    put(entry, numNames);
+    out.write(reinterpret_cast<const char*>(entry), 4);
+    for (size_t i = 0; i < players.size(); i++) {
+        auto found = names.find(players[i]);
+        if (found == names.end()) continue;
+        const size_t length = std::min<size_t>(found->second.size(), 0xFFFF);
+        put(put(entry, static_cast<uint32_t>(i)), static_cast<uint16_t>(length));
+        out.write(reinterpret_cast<const char*>(entry), 6);
+        out.write(found->second.data(), static_cast<std::streamsize>(length));
+    }
+
+    uint8_t footer[FOOTER_SIZE];
+    uint8_t* p = put(put(put(put(put(footer, indexOffset), playersOffset),
+                             static_cast<uint64_t>(blocks.size())), count), VERSION);
+    std::memcpy(p, MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(footer), FOOTER_SIZE);
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Error while writing the hand log");
+    }
+}
+
+HandLog::HandLog(const std::string& path) : file(path), numRecords(0) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(file.data());
+    const size_t size = file.size();
+    if (size < FILE_HEADER_SIZE + FOOTER_SIZE || std::memcmp(data, MAGIC, 4) != 0 ||
+        std::memcmp(data + size - 4, MAGIC, 4) != 0) {
+        throw std::runtime_error(path + " is not a hand log");
+    }
+
+    uint32_t version;
+    get(data + 4, version);
+    uint64_t indexOffset, playersOffset, numBlocks, records;
+    get(get(get(get(data + size - FOOTER_SIZE, indexOffset), playersOffset), numBlocks), records);
+    if (version != HandLogWriter::VERSION) {
+        throw std::runtime_error("Unsupported hand log version in " + path);
+    }
+    const uint64_t footerOffset = size - FOOTER_SIZE;
+    if (indexOffset < FILE_HEADER_SIZE || indexOffset + numBlocks * BLOCK_INFO_SIZE != playersOffset ||
+        playersOffset + 8 > footerOffset) {
+        throw std::runtime_error("Corrupt hand log " + path);
+    }
+
+    // Index des blocs
+    const uint8_t* p = data + indexOffset;
+    blocks.resize(numBlocks);
+    for (auto& info : blocks) {
+        uint32_t compressedFlag;
+        p = get(get(get(get(get(p, info.offset), info.storedSize), info.rawSize), info.records), compressedFlag);
+        info.compressed = compressedFlag != 0;
+        info.firstRecord = numRecords;
+        numRecords += info.records;
+        if (info.offset < FILE_HEADER_SIZE || info.offset + info.storedSize > indexOffset ||
+            (!info.compressed && info.storedSize != info.rawSize)) {
+            throw std::runtime_error("Corrupt hand log " + path);
+        }
+    }
+    if (numRecords != records) {
+        throw std::runtime_error("Corrupt hand log " + path);
+    }
+
+    // Joueurs et noms
+    const uint8_t* end = data + footerOffset;
+    uint32_t numPlayers;
+    p = get(p, numPlayers);
+    if (static_cast<uint64_t>(end - p) < numPlayers * 8ULL + 4) {
+        throw std::runtime_error("Corrupt hand log " + path);
+    }
+    players.resize(numPlayers);
+    for (auto& id : players) {
+        p = get(p, id);
+    }
+
+    uint32_t numNames;
+    p = get(p, numNames);
+    for (uint32_t i = 0; i < numNames; i++) {
+        uint32_t index;
+        uint16_t length;
+        if (end - p < 6) throw std::runtime_error("Corrupt hand log " + path);
+        p = get(get(p, index), length);
+        if (end - p < length || index >= numPlayers) throw std::runtime_error("Corrupt hand log " + path);
+        names.emplace(players[index], std::string(reinterpret_cast<const char*>(p), length));
+        p += length;
+    }
+}
+
+bool HandLog::isHandLog(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && std::memcmp(magic, MAGIC, 4) == 0;
+}
+
+HandLogCursor::HandLogCursor(const HandLog& handLog, size_t firstBlock, size_t lastBlock)
+    : log(handLog), block(firstBlock), endBlock(std::min(lastBlock, handLog.blocks.size())),
+      position(nullptr), blockEnd(nullptr), previousHandId(0), previousTimestamp(0) {
+}
+
+void HandLogCursor::loadBlock(size_t index) {
+    const HandLog::BlockInfo& info = log.blocks[index];
+    const uint8_t* stored = reinterpret_cast<const uint8_t*>(log.file.data()) + info.offset;
+
+    if (info.compressed) {
+        if (buffer.size() < info.rawSize) buffer.resize(info.rawSize);
+        if (!lzDecompress(stored, info.storedSize, buffer.data(), info.rawSize)) {
+            throw std::runtime_error("Corrupt hand log block");
+        }
+        position = buffer.data();
+    } else {
+        position = stored; // Bloc stocké tel quel: lu directement dans le fichier mappé
+    }
+    blockEnd = position + info.rawSize;
+    previousHandId = 0;
+    previousTimestamp = 0;
+}
+
+bool HandLogCursor::next(HandLogEntry& entry) {
+    while (position == blockEnd) {
+        if (block >= endBlock) return false;
+        loadBlock(block++);
+    }
+
+    uint16_t length;
+    if (blockEnd - position < 2) throw std::runtime_error("Corrupt hand log record");
+    const uint8_t* p = get(position, length);
+    const uint8_t* end = p + length;
+    if (end > blockEnd) throw std::runtime_error("Corrupt hand log record");
+
+    uint64_t value;
+    p = readVarint(p, end, value);
+    entry.handId = previousHandId + static_cast<uint64_t>(unzigzag(value));
+    p = readVarint(p, end, entry.tournamentId);
+    p = readVarint(p, end, value);
+    entry.timestamp = previousTimestamp + unzigzag(value);
+    p = readVarint(p, end, entry.tableId);
+    p = readSigned(p, end, entry.smallBlind);
+    p = readSigned(p, end, entry.bigBlind);
+    p = readSigned(p, end, entry.ante);
+    if (end - p < 5) throw std::runtime_error("Corrupt hand log record");
+    entry.flags = *p++;
+    entry.numSeats = *p++;
+    entry.button = *p++;
+    entry.boardCount = *p++;
+    entry.numActions = *p++;
+    if (entry.numSeats > HandRecord::MAX_SEATS || entry.numActions > HandRecord::MAX_ACTIONS ||
+        entry.boardCount > 5 || end - p < entry.boardCount) {
+        throw std::runtime_error("Corrupt hand log record");
+    }
+    std::fill(entry.board, entry.board + 5, HandRecord::NO_CARD);
+    std::copy(p, p + entry.boardCount, entry.board);
+    p += entry.boardCount;
+
+    uint64_t seatsLength;
+    p = readVarint(p, end, seatsLength);
+    if (static_cast<uint64_t>(end - p) < seatsLength) throw std::runtime_error("Corrupt hand log record");
+
+    entry.log = &log;
+    entry.seatData = p;
+    entry.actionData = p + seatsLength;
+    entry.end = end;
+
+    previousHandId = entry.handId;
+    previousTimestamp = entry.timestamp;
+    position = end;
+    return true;
+}
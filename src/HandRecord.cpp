@@ -0,0 +1,226 @@
+#include "../include/HandRecord.h"
+#include "BinaryIO.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using BinaryIO::put;
+using BinaryIO::get;
+
+namespace {
+    const char MAGIC[4] = {'P', 'S', 'H', 'H'};
+    const size_t FILE_HEADER_SIZE = 24;
+}
+
+void HandRecord::clear() {
+    handId = 0;
+    tournamentId = 0;
+    timestamp = 0;
+    tableId = 0;
+    smallBlind = 0;
+    bigBlind = 0;
+    ante = 0;
+    flags = 0;
+    numSeats = 0;
+    button = NO_CARD;
+    boardCount = 0;
+    std::memset(board, NO_CARD, sizeof(board));
+    numActions = 0;
+}
+
+uint64_t HandRecord::playerId(const char* name, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(name[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+size_t HandRecord::serialize(uint8_t* out) const {
+    uint8_t* p = out + 2; // Taille écrite à la fin
+    p = put(p, handId);
+    p = put(p, tournamentId);
+    p = put(p, timestamp);
+    p = put(p, tableId);
+    p = put(p, smallBlind);
+    p = put(p, bigBlind);
+    p = put(p, ante);
+    *p++ = flags;
+    *p++ = numSeats;
+    *p++ = button;
+    *p++ = boardCount;
+    std::memcpy(p, board, 5);
+    p += 5;
+    *p++ = numActions;
+
+    for (int s = 0; s < numSeats; s++) {
+        const HistorySeat& seat = seats[s];
+        p = put(p, seat.playerId);
+        p = put(p, seat.stack);
+        p = put(p, seat.invested);
+        p = put(p, seat.collected);
+        *p++ = seat.seatNumber;
+        *p++ = seat.cards[0];
+        *p++ = seat.cards[1];
+        *p++ = seat.flags;
+    }
+
+    for (int a = 0; a < numActions; a++) {
+        const HistoryAction& action = actions[a];
+        *p++ = action.seat;
+        *p++ = action.street;
+        *p++ = static_cast<uint8_t>(action.type);
+        *p++ = action.allIn ? 1 : 0;
+        p = put(p, action.amount);
+    }
+
+    size_t size = static_cast<size_t>(p - out);
+    put(out, static_cast<uint16_t>(size));
+    return size;
+}
+
+size_t HandRecord::deserialize(const uint8_t* in, size_t available, HandRecord& record) {
+    if (available < 56) return 0;
+    uint16_t size;
+    const uint8_t* p = get(in, size);
+    if (size < 56 || size > available) return 0;
+
+    p = get(p, record.handId);
+    p = get(p, record.tournamentId);
+    p = get(p, record.timestamp);
+    p = get(p, record.tableId);
+    p = get(p, record.smallBlind);
+    p = get(p, record.bigBlind);
+    p = get(p, record.ante);
+    record.flags = *p++;
+    record.numSeats = *p++;
+    record.button = *p++;
+    record.boardCount = *p++;
+    std::memcpy(record.board, p, 5);
+    p += 5;
+    record.numActions = *p++;
+
+    if (record.numSeats > MAX_SEATS || record.numActions > MAX_ACTIONS ||
+        size != 56 + record.numSeats * 24 + record.numActions * 8) {
+        return 0;
+    }
+
+    for (int s = 0; s < record.numSeats; s++) {
+        HistorySeat& seat = record.seats[s];
+        p = get(p, seat.playerId);
+        p = get(p, seat.stack);
+        p = get(p, seat.invested);
+        p = get(p, seat.collected);
+        seat.seatNumber = *p++;
+        seat.cards[0] = *p++;
+        seat.cards[1] = *p++;
+        seat.flags = *p++;
+    }
+
+    for (int a = 0; a < record.numActions; a++) {
+        HistoryAction& action = record.actions[a];
+        action.seat = *p++;
+        action.street = *p++;
+        action.type = static_cast<HistoryActionType>(*p++);
+        action.allIn = *p++ != 0;
+        p = get(p, action.amount);
+    }
+
+    return size;
+}
+
+HandRecordWriter::HandRecordWriter(const std::string& path)
+    : out(path, std::ios::binary | std::ios::trunc), count(0) {
+    if (!out) {
+        throw std::runtime_error("Cannot create " + path);
+    }
+    uint8_t header[FILE_HEADER_SIZE] = {0};
+    out.write(reinterpret_cast<const char*>(header), FILE_HEADER_SIZE);
+}
+
+void HandRecordWriter::write(const HandRecord& record) {
+    uint8_t buffer[HandRecord::MAX_SERIALIZED_SIZE];
+    size_t size = record.serialize(buffer);
+    writeSerialized(buffer, size, 1);
+}
+
+void HandRecordWriter::writeSerialized(const uint8_t* data, size_t size, uint64_t records) {
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+    count += records;
+}
+
+void HandRecordWriter::finish(const std::unordered_map<uint64_t, std::string>& names) {
+    uint64_t namesOffset = static_cast<uint64_t>(out.tellp());
+
+    uint8_t entry[8 + 2];
+    put(entry, static_cast<uint32_t>(names.size()));
+    out.write(reinterpret_cast<const char*>(entry), 4);
+    for (const auto& name : names) {
+        size_t length = std::min<size_t>(name.second.size(), 0xFFFF);
+        put(put(entry, name.first), static_cast<uint16_t>(length));
+        out.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+        out.write(name.second.data(), static_cast<std::streamsize>(length));
+    }
+
+    uint8_t header[FILE_HEADER_SIZE];
+    std::memcpy(header, MAGIC, 4);
+    put(put(put(header + 4, VERSION), count), namesOffset);
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(header), FILE_HEADER_SIZE);
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Error while writing the hand record file");
+    }
+}
+
+HandRecordReader::HandRecordReader(const std::string& path) : file(path), count(0) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(file.data());
+    const size_t size = file.size();
+    if (size < FILE_HEADER_SIZE || std::memcmp(data, MAGIC, 4) != 0) {
+        throw std::runtime_error(path + " is not a hand record file");
+    }
+
+    uint32_t version;
+    uint64_t namesOffset;
+    get(get(get(data + 4, version), count), namesOffset);
+    if (version != HandRecordWriter::VERSION) {
+        throw std::runtime_error("Unsupported hand record version in " + path);
+    }
+    if (namesOffset < FILE_HEADER_SIZE || namesOffset + 4 > size) {
+        throw std::runtime_error("Corrupt hand record file " + path);
+    }
+
+    // Table des noms
+    const uint8_t* p = data + namesOffset;
+    const uint8_t* end = data + size;
+    uint32_t numNames;
+    p = get(p, numNames);
+    names.reserve(numNames);
+    for (uint32_t i = 0; i < numNames; i++) {
+        uint64_t id;
+        uint16_t length;
+        if (end - p < 10) throw std::runtime_error("Corrupt hand record file " + path);
+        p = get(get(p, id), length);
+        if (end - p < length) throw std::runtime_error("Corrupt hand record file " + path);
+        names.emplace(id, std::string(reinterpret_cast<const char*>(p), length));
+        p += length;
+    }
+
+    recordsEnd = data + namesOffset;
+    rewind();
+}
+
+bool HandRecordReader::next(HandRecord& record) {
+    if (position >= recordsEnd) return false;
+    size_t size = HandRecord::deserialize(position, static_cast<size_t>(recordsEnd - position), record);
+    if (size == 0) {
+        throw std::runtime_error("Corrupt hand record");
+    }
+    position += size;
+    return true;
+}
+
+void HandRecordReader::rewind() {
+    position = reinterpret_cast<const uint8_t*>(file.data()) + FILE_HEADER_SIZE;
+}
@@ -0,0 +1,170 @@
+#include "../include/ICMCalculator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+const int MAX_EXACT_PLAYERS = 20;
+
+int bitCount(unsigned int mask) {
+    int count = 0;
+    while (mask) {
+        mask &= mask - 1;
+        count++;
+    }
+    return count;
+}
+
+// Indices of players still in the tournament
+std::vector<int> activePlayers(const std::vector<double>& stacks) {
+    std::vector<int> active;
+    for (size_t i = 0; i < stacks.size(); i++) {
+        if (stacks[i] < 0.0) {
+            throw std::invalid_argument("Stacks cannot be negative");
+        }
+        if (stacks[i] > 0.0) {
+            active.push_back(static_cast<int>(i));
+        }
+    }
+    return active;
+}
+
+} // namespace
+
+ICMCalculator::ICMCalculator(const std::vector<double>& prizes, int maxExactPlayers, int trials)
+    : payouts(prizes), exactLimit(std::min(maxExactPlayers, MAX_EXACT_PLAYERS)), monteCarloTrials(trials) {
+    if (payouts.empty()) {
+        throw std::invalid_argument("At least one paid place required");
+    }
+    if (monteCarloTrials <= 0) {
+        throw std::invalid_argument("Monte Carlo trials must be positive");
+    }
+}
+
+std::vector<double> ICMCalculator::equities(const std::vector<double>& stacks) const {
+    if (static_cast<int>(activePlayers(stacks).size()) <= exactLimit) {
+        return exactEquities(stacks);
+    }
+    return monteCarloEquities(stacks, monteCarloTrials);
+}
+
+std::vector<double> ICMCalculator::equitiesAfterHand(const std::vector<double>& stacks,
+                                                     const std::vector<int>& inHand) const {
+    std::vector<double> result = equities(stacks);
+    const int survivors = static_cast<int>(activePlayers(stacks).size());
+
+    std::vector<int> busted;
+    for (int player : inHand) {
+        if (player < 0 || player >= static_cast<int>(stacks.size())) {
+            throw std::out_of_range("Invalid player index");
+        }
+        if (stacks[player] == 0.0 && std::find(busted.begin(), busted.end(), player) == busted.end()) {
+            busted.push_back(player);
+        }
+    }
+    if (busted.empty()) {
+        return result;
+    }
+
+    // Éliminés ensemble: places juste sous les joueurs restants, prix partagés à parts égales
+    double shared = 0.0;
+    for (size_t k = 0; k < busted.size(); k++) {
+        const size_t place = static_cast<size_t>(survivors) + k;
+        if (place < payouts.size()) shared += payouts[place];
+    }
+    for (int player : busted) {
+        result[player] = shared / busted.size();
+    }
+    return result;
+}
+
+double ICMCalculator::equity(const std::vector<double>& stacks, int player) const {
+    if (player < 0 || player >= static_cast<int>(stacks.size())) {
+        throw std::out_of_range("Invalid player index");
+    }
+    return equities(stacks)[player];
+}
+
+std::vector<double> ICMCalculator::exactEquities(const std::vector<double>& stacks) const {
+    std::vector<int> active = activePlayers(stacks);
+    const int n = static_cast<int>(active.size());
+    if (n > MAX_EXACT_PLAYERS) {
+        throw std::invalid_argument("Too many players for exact ICM");
+    }
+
+    std::vector<double> result(stacks.size(), 0.0);
+    if (n == 0) {
+        return result;
+    }
+
+    const int paid = std::min(n, static_cast<int>(payouts.size()));
+    const unsigned int full = 1u << n;
+
+    // prob[mask] = probability that exactly the players in mask take places 1..|mask|
+    std::vector<double> prob(full, 0.0);
+    std::vector<double> placedChips(full, 0.0);
+    prob[0] = 1.0;
+
+    double total = 0.0;
+    for (int idx : active) total += stacks[idx];
+
+    // Subsets are always numerically smaller than their supersets,
+    // so increasing mask order visits each state after all its sources.
+    for (unsigned int mask = 0; mask < full; mask++) {
+        if (mask) {
+            int low = 0;
+            while (!(mask & (1u << low))) low++;
+            placedChips[mask] = placedChips[mask & (mask - 1)] + stacks[active[low]];
+        }
+
+        if (prob[mask] == 0.0) continue;
+
+        int place = bitCount(mask);
+        if (place >= paid) continue;
+
+        double remaining = total - placedChips[mask];
+        for (int i = 0; i < n; i++) {
+            if (mask & (1u << i)) continue;
+            double p = prob[mask] * stacks[active[i]] / remaining;
+            result[active[i]] += p * payouts[place];
+            prob[mask | (1u << i)] += p;
+        }
+    }
+
+    return result;
+}
+
+std::vector<double> ICMCalculator::monteCarloEquities(const std::vector<double>& stacks,
+                                                      int trials, unsigned int seed) const {
+    std::vector<int> active = activePlayers(stacks);
+    const int n = static_cast<int>(active.size());
+    std::vector<double> result(stacks.size(), 0.0);
+    if (n == 0 || trials <= 0) {
+        return result;
+    }
+
+    const int paid = std::min(n, static_cast<int>(payouts.size()));
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::pair<double, int>> keys(n);
+
+    // With E_i ~ Exp(1), sorting E_i / stack_i in increasing order yields
+    // exactly the Harville finishing-order distribution.
+    for (int t = 0; t < trials; t++) {
+        for (int i = 0; i < n; i++) {
+            double e = -std::log(1.0 - uniform(rng));
+            keys[i] = {e / stacks[active[i]], active[i]};
+        }
+        std::partial_sort(keys.begin(), keys.begin() + paid, keys.end());
+        for (int place = 0; place < paid; place++) {
+            result[keys[place].second] += payouts[place];
+        }
+    }
+
+    for (auto& value : result) {
+        value /= trials;
+    }
+    return result;
+}
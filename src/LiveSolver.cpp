@@ -0,0 +1,187 @@
+#include "../include/LiveSolver.h"
+#include "../include/SolverStats.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+LiveSolver::LiveSolver(int firstChunkSize, int maxChunkSize, size_t cacheEntries)
+    : solver(firstChunkSize), firstChunk(std::max(1, firstChunkSize)),
+      maxChunk(std::max(std::max(1, firstChunkSize), maxChunkSize)),
+      maxCacheEntries(std::max<size_t>(1, cacheEntries)), generation(0) {
+}
+
+std::string LiveSolver::spotKey(const LiveSpot& spot) {
+    // Cartes privatives triées, tableau trié, nombre d'adversaires: l'ordre des cartes ne change pas l'équité
+    std::string key;
+    int hole[2] = {spot.holeCards[0].toIndex(), spot.holeCards[1].toIndex()};
+    std::sort(hole, hole + 2);
+    std::vector<int> board;
+    for (const auto& card : spot.board) {
+        board.push_back(card.toIndex());
+    }
+    std::sort(board.begin(), board.end());
+
+    key.push_back(static_cast<char>(hole[0]));
+    key.push_back(static_cast<char>(hole[1]));
+    for (int card : board) {
+        key.push_back(static_cast<char>(card));
+    }
+    key.push_back(static_cast<char>(64 + spot.numOpponents));
+    return key;
+}
+
+LiveSolver::Tally LiveSolver::lookup(const std::string& key) const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(key);
+    if (Instrumentation::enabled()) {
+        Instrumentation::addCacheLookup(it != cache.end());
+    }
+    return it != cache.end() ? it->second : Tally();
+}
+
+LiveSolver::Tally LiveSolver::add(const std::string& key, const Tally& tally) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (cache.size() >= maxCacheEntries && cache.find(key) == cache.end()) {
+        cache.clear();
+    }
+    Tally& entry = cache[key];
+    entry.wins += tally.wins;
+    entry.ties += tally.ties;
+    entry.losses += tally.losses;
+    return entry;
+}
+
+LiveUpdate LiveSolver::makeUpdate(const LiveSpot& spot, const Tally& tally, uint64_t requestGeneration) const {
+    EquityResult equity;
+    const long long total = std::max(1LL, tally.total());
+    equity.simulations = static_cast<int>(std::min<long long>(tally.total(), INT32_MAX));
+    equity.winRate = tally.wins * 100.0 / total;
+    equity.tieRate = tally.ties * 100.0 / total;
+    equity.loseRate = tally.losses * 100.0 / total;
+
+    LiveUpdate update;
+    update.result = solver.decide(equity, spot.potSize, spot.callAmount);
+    update.simulationsDone = equity.simulations;
+    update.simulationsTarget = spot.simulations;
+    update.final = tally.total() >= spot.simulations;
+    update.generation = requestGeneration;
+    return update;
+}
+
+uint64_t LiveSolver::supersede() {
+    return ++generation;
+}
+
+bool LiveSolver::cached(const LiveSpot& spot, LiveUpdate& update) const {
+    if (spot.holeCards.size() != 2) return false;
+    Tally tally = lookup(spotKey(spot));
+    if (tally.total() == 0) return false;
+    update = makeUpdate(spot, tally, generation.load());
+    update.fromCache = true;
+    return true;
+}
+
+bool LiveSolver::solve(const LiveSpot& spot, uint64_t requestGeneration,
+                       const std::function<void(const LiveUpdate&)>& onUpdate) {
+    if (spot.holeCards.size() != 2) {
+        throw std::invalid_argument("Exactly 2 hole cards required");
+    }
+    if (spot.board.size() > 5) {
+        throw std::invalid_argument("Maximum 5 cards on the board");
+    }
+
+    TraceSpan span("live.solve", "job", spot.simulations);
+    const std::string key = spotKey(spot);
+    Tally tally = lookup(key);
+    if (tally.total() > 0 && onUpdate) {
+        LiveUpdate update = makeUpdate(spot, tally, requestGeneration);
+        update.fromCache = true;
+        onUpdate(update);
+    }
+
+    // Tranches croissantes: estimation rapide d'abord, puis affinage jusqu'à la cible
+    long long chunk = std::max<long long>(firstChunk, std::min<long long>(tally.total(), maxChunk));
+    while (tally.total() < spot.simulations) {
+        if (!isCurrent(requestGeneration)) return false;
+
+        const int size = static_cast<int>(std::min<long long>(chunk, spot.simulations - tally.total()));
+        EquityResult equity = solver.calculateEquity(spot.holeCards, spot.board, spot.numOpponents, size);
+
+        Tally part;
+        part.wins = std::llround(equity.winRate * size / 100.0);
+        part.ties = std::llround(equity.tieRate * size / 100.0);
+        part.losses = size - part.wins - part.ties;
+        tally = add(key, part);
+
+        if (!isCurrent(requestGeneration)) return false;
+        if (onUpdate) {
+            onUpdate(makeUpdate(spot, tally, requestGeneration));
+        }
+        chunk = std::min<long long>(chunk * 2, maxChunk);
+    }
+    return true;
+}
+
+bool LiveSolver::speculate(const LiveSpot& spot, uint64_t requestGeneration, int streets,
+                           const std::function<void(int, int)>& onProgress) {
+    if (spot.holeCards.size() != 2) {
+        throw std::invalid_argument("Exactly 2 hole cards required");
+    }
+    const int boardSize = static_cast<int>(spot.board.size());
+    if (boardSize < 3 || boardSize >= 5) {
+        return true;
+    }
+
+    bool dead[52] = {false};
+    dead[spot.holeCards[0].toIndex()] = dead[spot.holeCards[1].toIndex()] = true;
+    for (const auto& card : spot.board) {
+        dead[card.toIndex()] = true;
+    }
+    std::vector<int> cards;
+    for (int c = 0; c < 52; c++) {
+        if (!dead[c]) cards.push_back(c);
+    }
+
+    // Prochaine carte d'abord (la requête la plus probable), puis les paires de cartes suivantes
+    std::vector<std::vector<int>> additions;
+    for (int a : cards) {
+        additions.push_back({a});
+    }
+    if (streets >= 2 && boardSize + 2 <= 5) {
+        for (size_t i = 0; i < cards.size(); i++) {
+            for (size_t j = i + 1; j < cards.size(); j++) {
+                additions.push_back({cards[i], cards[j]});
+            }
+        }
+    }
+
+    TraceSpan span("live.speculate", "job", static_cast<int64_t>(additions.size()));
+    const int total = static_cast<int>(additions.size());
+    LiveSpot next = spot;
+    for (int done = 0; done < total; done++) {
+        TraceSpan street(additions[done].size() == 1 ? "next street" : "two streets ahead", "street",
+                         boardSize + static_cast<int64_t>(additions[done].size()));
+        next.board = spot.board;
+        for (int card : additions[done]) {
+            next.board.push_back(Card::fromIndex(card));
+        }
+        if (!solve(next, requestGeneration, nullptr)) {
+            return false;
+        }
+        if (onProgress) {
+            onProgress(done + 1, total);
+        }
+    }
+    return true;
+}
+
+size_t LiveSolver::getCacheSize() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cache.size();
+}
+
+void LiveSolver::clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cache.clear();
+}
@@ -0,0 +1,80 @@
+#include "../include/MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+
+MappedFile::MappedFile(const std::string& path)
+    : mapped(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot read the size of " + path);
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length == 0) {
+        return;
+    }
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map " + path);
+    }
+    mapped = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!mapped) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Cannot map " + path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (mapped) UnmapViewOfFile(mapped);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+}
+
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path) : mapped(nullptr), length(0), fd(-1) {
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read the size of " + path);
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        return;
+    }
+
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Cannot map " + path);
+    }
+    madvise(address, length, MADV_SEQUENTIAL);
+    mapped = static_cast<const char*>(address);
+}
+
+MappedFile::~MappedFile() {
+    if (mapped) munmap(const_cast<char*>(mapped), length);
+    if (fd >= 0) ::close(fd);
+}
+
+#endif
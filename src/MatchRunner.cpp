@@ -0,0 +1,327 @@
+#include "../include/MatchRunner.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const long long DEALS_PER_CHUNK = 64;
+
+/**
+ * Running sums per agent. The sample unit is a duplicate group (one deal
+ * played in every rotation), or a single hand without duplicate.
+ */
+struct MatchTotals {
+    long long deals = 0;
+    long long hands = 0;
+    std::vector<double> sum, sumSq, adjustedSum, adjustedSumSq;
+    std::vector<long long> allIns;
+
+    explicit MatchTotals(int agents)
+        : sum(agents, 0.0), sumSq(agents, 0.0), adjustedSum(agents, 0.0),
+          adjustedSumSq(agents, 0.0), allIns(agents, 0) {}
+
+    void merge(MatchTotals& other) {
+        deals += other.deals;
+        hands += other.hands;
+        for (size_t a = 0; a < sum.size(); a++) {
+            sum[a] += other.sum[a];
+            sumSq[a] += other.sumSq[a];
+            adjustedSum[a] += other.adjustedSum[a];
+            adjustedSumSq[a] += other.adjustedSumSq[a];
+            allIns[a] += other.allIns[a];
+        }
+        other = MatchTotals(static_cast<int>(sum.size()));
+    }
+};
+
+// bb/100 and 95% confidence half-width from per-group sums
+void winRate(double sum, double sumSq, long long groups, int handsPerGroup, double& rate, double& ci) {
+    rate = ci = 0.0;
+    if (groups <= 0) return;
+
+    double mean = sum / groups;
+    rate = 100.0 * mean / handsPerGroup;
+    if (groups > 1) {
+        double variance = std::max(0.0, (sumSq - sum * mean) / (groups - 1));
+        ci = 1.96 * 100.0 * std::sqrt(variance / groups) / handsPerGroup;
+    }
+}
+
+MatchResult summarize(const MatchTotals& totals, const std::vector<std::string>& names,
+                      bool duplicate, double seconds) {
+    const int numAgents = static_cast<int>(names.size());
+    const int handsPerGroup = duplicate ? numAgents : 1;
+    const long long groups = duplicate ? totals.deals : totals.hands;
+
+    MatchResult result;
+    result.deals = totals.deals;
+    result.hands = totals.hands;
+    result.numPlayers = numAgents;
+    result.duplicate = duplicate;
+    result.seconds = seconds;
+
+    for (int a = 0; a < numAgents; a++) {
+        AgentMatchStats stats;
+        stats.name = names[a];
+        stats.hands = totals.hands;
+        stats.allIns = totals.allIns[a];
+        winRate(totals.sum[a], totals.sumSq[a], groups, handsPerGroup, stats.bbPer100, stats.bbPer100Ci);
+        winRate(totals.adjustedSum[a], totals.adjustedSumSq[a], groups, handsPerGroup,
+                stats.adjustedBbPer100, stats.adjustedBbPer100Ci);
+        result.agents.push_back(stats);
+    }
+    return result;
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+int playersInHand(const PokerGame& game) {
+    int count = 0;
+    for (int s = 0; s < game.getNumPlayers(); s++) {
+        if (game.getPlayer(s)->isActive()) count++;
+    }
+    return count;
+}
+
+// Betting closed with several players left: at most one of them still has chips
+bool bettingClosed(const PokerGame& game) {
+    int withChips = 0;
+    for (int s = 0; s < game.getNumPlayers(); s++) {
+        if (game.getPlayer(s)->canAct()) withChips++;
+    }
+    return withChips <= 1 && playersInHand(game) > 1;
+}
+
+} // namespace
+
+std::string MatchResult::toString() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "=== Match Results ===\n";
+    oss << "Deals: " << deals << "   Hands: " << hands
+        << (duplicate ? "   (duplicate)" : "") << "   Time: " << seconds << "s\n";
+    for (const auto& agent : agents) {
+        oss << agent.name << ": " << agent.bbPer100 << " +/- " << agent.bbPer100Ci << " bb/100"
+            << "   all-in adjusted: " << agent.adjustedBbPer100 << " +/- " << agent.adjustedBbPer100Ci
+            << " bb/100   (" << agent.allIns << " all-ins)\n";
+    }
+    return oss.str();
+}
+
+std::string MatchResult::toJson() const {
+    std::ostringstream oss;
+    oss << std::setprecision(6);
+    oss << "{\n";
+    oss << "  \"deals\": " << deals << ",\n";
+    oss << "  \"hands\": " << hands << ",\n";
+    oss << "  \"players\": " << numPlayers << ",\n";
+    oss << "  \"duplicate\": " << (duplicate ? "true" : "false") << ",\n";
+    oss << "  \"seconds\": " << seconds << ",\n";
+    oss << "  \"agents\": [\n";
+    for (size_t i = 0; i < agents.size(); i++) {
+        const AgentMatchStats& agent = agents[i];
+        oss << "    {\"name\": \"" << jsonEscape(agent.name) << "\", "
+            << "\"hands\": " << agent.hands << ", "
+            << "\"bb_per_100\": " << agent.bbPer100 << ", "
+            << "\"bb_per_100_ci95\": " << agent.bbPer100Ci << ", "
+            << "\"adjusted_bb_per_100\": " << agent.adjustedBbPer100 << ", "
+            << "\"adjusted_bb_per_100_ci95\": " << agent.adjustedBbPer100Ci << ", "
+            << "\"all_ins\": " << agent.allIns << "}"
+            << (i + 1 < agents.size() ? "," : "") << "\n";
+    }
+    oss << "  ]\n";
+    oss << "}\n";
+    return oss.str();
+}
+
+MatchRunner::MatchRunner(const MatchConfig& matchConfig) : config(matchConfig) {
+    if (config.deals <= 0) {
+        throw std::invalid_argument("At least one deal required");
+    }
+    if (config.stack < config.bigBlind) {
+        throw std::invalid_argument("Stack must cover the big blind");
+    }
+    if (config.allInRunouts < 1) {
+        throw std::invalid_argument("At least one all-in runout required");
+    }
+}
+
+void MatchRunner::addAgent(const std::string& name, const AgentFactory& factory) {
+    if (!factory) {
+        throw std::invalid_argument("Agent factory required");
+    }
+    if (names.size() >= static_cast<size_t>(PokerGame::MAX_PLAYERS)) {
+        throw std::invalid_argument("At most 9 agents");
+    }
+    names.push_back(name);
+    factories.push_back(factory);
+}
+
+MatchResult MatchRunner::run(const std::function<void(const MatchResult&)>& progress) {
+    const int numAgents = static_cast<int>(names.size());
+    if (numAgents < 2) {
+        throw std::invalid_argument("At least two agents required");
+    }
+
+    TraceSpan span("match", "job", config.deals);
+    const int rotations = config.duplicate ? numAgents : 1;
+    const double bigBlind = config.bigBlind;
+    auto start = std::chrono::steady_clock::now();
+
+    MatchTotals totals(numAgents);
+    std::mutex totalsMutex;
+    std::atomic<long long> next(0);
+    long long nextReport = config.reportEvery;
+    std::exception_ptr failure;
+
+    int numThreads = config.threads > 0
+        ? config.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    long long chunks = (config.deals + DEALS_PER_CHUNK - 1) / DEALS_PER_CHUNK;
+    numThreads = static_cast<int>(std::max(1LL, std::min<long long>(numThreads, chunks)));
+
+    auto worker = [&](int threadIndex) {
+        try {
+            PokerGame game(numAgents, config.smallBlind, config.bigBlind, config.stack);
+            game.setSilent(true);
+
+            std::vector<std::unique_ptr<PokerAgent>> agents;
+            for (int a = 0; a < numAgents; a++) {
+                agents.push_back(factories[a](config.seed + 7919u * (threadIndex + 1) + 31u * a));
+            }
+
+            MatchTotals local(numAgents);
+            std::vector<double> groupActual(numAgents), groupAdjusted(numAgents);
+            std::vector<int> contributions(numAgents);
+            std::vector<std::vector<Card>> holeCards(numAgents);
+
+            for (long long first = next.fetch_add(DEALS_PER_CHUNK); first < config.deals;
+                 first = next.fetch_add(DEALS_PER_CHUNK)) {
+                long long last = std::min(config.deals, first + DEALS_PER_CHUNK);
+                TraceSpan chunk("match deals", "chunk", first);
+
+                for (long long deal = first; deal < last; deal++) {
+                    unsigned int dealSeed = config.seed ^ static_cast<unsigned int>(deal * 2654435761ULL);
+                    std::fill(groupActual.begin(), groupActual.end(), 0.0);
+                    std::fill(groupAdjusted.begin(), groupAdjusted.end(), 0.0);
+
+                    for (int rotation = 0; rotation < rotations; rotation++) {
+                        // Bouton fixe: ce sont les agents qui tournent autour de la table
+                        // (à chaque rotation en duplicate, d'une donne à l'autre sinon)
+                        int shift = config.duplicate ? rotation : static_cast<int>(deal % numAgents);
+                        for (int seat = 0; seat < numAgents; seat++) {
+                            game.setAgent(seat, agents[(seat + shift) % numAgents].get());
+                            Player* player = game.getPlayer(seat);
+                            player->addChips(config.stack - player->getStack());
+                        }
+                        game.setSeed(dealSeed);
+                        game.setDealerPosition(0);
+
+                        game.startNewHand();
+                        game.bettingRound();
+
+                        bool allIn = false;
+                        std::vector<double> expected;
+                        for (int street = 0; street < 3 && playersInHand(game) > 1; street++) {
+                            if (config.allInAdjust && !allIn && bettingClosed(game)) {
+                                allIn = true;
+                                for (int seat = 0; seat < numAgents; seat++) {
+                                    holeCards[seat] = game.getPlayer(seat)->getHoleCards();
+                                    contributions[seat] = game.getPlayer(seat)->getTotalBetInHand();
+                                }
+                                expected = PotManager::allInExpectedWinnings(holeCards, game.getBoard(), contributions,
+                                                                             config.allInRunouts, 1, dealSeed);
+                            }
+                            if (street == 0) game.dealFlop();
+                            else if (street == 1) game.dealTurn();
+                            else game.dealRiver();
+                            game.bettingRound();
+                        }
+                        game.showdown();
+
+                        for (int seat = 0; seat < numAgents; seat++) {
+                            int agent = (seat + shift) % numAgents;
+                            double actual = (game.getPlayer(seat)->getStack() - config.stack) / bigBlind;
+                            groupActual[agent] += actual;
+                            groupAdjusted[agent] += allIn
+                                ? (expected[seat] - contributions[seat]) / bigBlind
+                                : actual;
+                            if (allIn && game.getPlayer(seat)->getTotalBetInHand() > 0
+                                && !holeCards[seat].empty()) {
+                                local.allIns[agent]++;
+                            }
+                        }
+                        local.hands++;
+
+                        if (!config.duplicate) {
+                            for (int a = 0; a < numAgents; a++) {
+                                local.sum[a] += groupActual[a];
+                                local.sumSq[a] += groupActual[a] * groupActual[a];
+                                local.adjustedSum[a] += groupAdjusted[a];
+                                local.adjustedSumSq[a] += groupAdjusted[a] * groupAdjusted[a];
+                                groupActual[a] = groupAdjusted[a] = 0.0;
+                            }
+                        }
+                    }
+
+                    if (config.duplicate) {
+                        for (int a = 0; a < numAgents; a++) {
+                            local.sum[a] += groupActual[a];
+                            local.sumSq[a] += groupActual[a] * groupActual[a];
+                            local.adjustedSum[a] += groupAdjusted[a];
+                            local.adjustedSumSq[a] += groupAdjusted[a] * groupAdjusted[a];
+                        }
+                    }
+                    local.deals++;
+                }
+
+                std::lock_guard<std::mutex> lock(totalsMutex);
+                totals.merge(local);
+                if (progress && totals.deals >= nextReport && totals.deals < config.deals) {
+                    while (nextReport <= totals.deals) nextReport += std::max(1LL, config.reportEvery);
+                    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    progress(summarize(totals, names, config.duplicate, seconds));
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(totalsMutex);
+            if (!failure) failure = std::current_exception();
+            next = config.deals; // Stop the other workers
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < numThreads; t++) {
+        workers.emplace_back(worker, t);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    MatchResult result = summarize(totals, names, config.duplicate, seconds);
+    if (progress) {
+        progress(result);
+    }
+    return result;
+}
@@ -0,0 +1,410 @@
+#include "../include/PlayerStats.h"
+#include "HandLog.h"
+#include "PokerGame.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+    const size_t BLOCKS_PER_BATCH = 4;
+
+    // Clé de groupe: index du joueur (32 bits), position, profondeur et texture (4 bits chacune)
+    const int POSITION_SHIFT = 32;
+    const int STACK_SHIFT = 36;
+    const int TEXTURE_SHIFT = 40;
+
+    const char* const POSITION_NAMES[] = {"BTN", "SB", "BB", "UTG", "MP", "HJ", "CO", "?"};
+    const char* const STACK_NAMES[] = {"<20bb", "20-40bb", "40-75bb", "75-125bb", "125bb+"};
+    const char* const TEXTURE_NAMES[] = {"no flop", "paired", "monotone", "two-tone", "rainbow"};
+
+    typedef std::unordered_map<uint64_t, StatsCounters> CounterTable;
+
+    // Position comptée depuis le bouton; en tête-à-tête le bouton est aussi la petite blinde
+    int positionOf(int seat, int button, int numSeats) {
+        if (button >= numSeats) return 7;
+        const int offset = (seat - button + numSeats) % numSeats;
+        if (numSeats == 2) return offset == 0 ? 0 : 2;
+        if (offset < 3) return offset;
+        if (offset == numSeats - 1) return 6;
+        if (offset == numSeats - 2 && offset > 3) return 5;
+        return offset == 3 ? 3 : 4;
+    }
+
+    int stackBucket(int32_t stack, int32_t bigBlind) {
+        const double bb = static_cast<double>(stack) / bigBlind;
+        if (bb < 20.0) return 0;
+        if (bb < 40.0) return 1;
+        if (bb < 75.0) return 2;
+        if (bb < 125.0) return 3;
+        return 4;
+    }
+
+    int flopTexture(const uint8_t* board, int boardCount) {
+        if (boardCount < 3) return 0;
+        const int r0 = board[0] % 13, r1 = board[1] % 13, r2 = board[2] % 13;
+        if (r0 == r1 || r0 == r2 || r1 == r2) return 1;
+        const int s0 = board[0] / 13, s1 = board[1] / 13, s2 = board[2] / 13;
+        if (s0 == s1 && s1 == s2) return 2;
+        if (s0 == s1 || s0 == s2 || s1 == s2) return 3;
+        return 4;
+    }
+
+    bool isPost(HistoryActionType type) {
+        return type == HistoryActionType::POST_SMALL_BLIND || type == HistoryActionType::POST_BIG_BLIND ||
+               type == HistoryActionType::POST_ANTE || type == HistoryActionType::POST_BLIND;
+    }
+
+    bool isAggressive(HistoryActionType type) {
+        return type == HistoryActionType::BET || type == HistoryActionType::RAISE;
+    }
+
+    // Ajoute chaque siège retenu d'une main à la table du thread
+    void addHand(const HandLogEntry& entry, const HistorySeat* seats, const uint32_t* players,
+                 const HistoryAction* actions, bool filterPlayer,
+                 uint32_t filterIndex, uint64_t groupMask, CounterTable& table) {
+        const int numSeats = entry.numSeats;
+        const bool flop = entry.boardCount >= 3;
+
+        // Préflop: VPIP, PFR, 3-bet; flop: c-bet
+        unsigned vpip = 0, pfr = 0, threeBetChances = 0, threeBets = 0, foldedPreflop = 0;
+        unsigned cbetChance = 0, cbet = 0, flopActed = 0;
+        int raises = 0;
+        int lastRaiser = -1;
+        bool flopBet = false;
+
+        for (int a = 0; a < entry.numActions; a++) {
+            const HistoryAction& action = actions[a];
+            if (action.type == HistoryActionType::UNCALLED || isPost(action.type) || action.seat >= numSeats) {
+                continue;
+            }
+            const unsigned bit = 1u << action.seat;
+
+            if (action.street == static_cast<uint8_t>(GamePhase::PRE_FLOP)) {
+                if (raises == 1 && lastRaiser != action.seat && !(threeBetChances & bit)) {
+                    threeBetChances |= bit;
+                    if (isAggressive(action.type)) threeBets |= bit;
+                }
+                if (action.type == HistoryActionType::FOLD) {
+                    foldedPreflop |= bit;
+                } else if (action.type != HistoryActionType::CHECK) {
+                    vpip |= bit;
+                }
+                if (isAggressive(action.type)) {
+                    pfr |= bit;
+                    raises++;
+                    lastRaiser = action.seat;
+                }
+            } else if (action.street == static_cast<uint8_t>(GamePhase::FLOP)) {
+                if (action.seat == lastRaiser && !(flopActed & bit) && !flopBet) {
+                    cbetChance |= bit;
+                    if (action.type == HistoryActionType::BET) cbet |= bit;
+                }
+                flopActed |= bit;
+                flopBet = flopBet || isAggressive(action.type);
+            }
+        }
+
+        int live = 0;
+        for (int s = 0; s < numSeats; s++) {
+            live += (seats[s].flags & HistorySeat::FOLDED) ? 0 : 1;
+        }
+        const uint64_t textureKey = static_cast<uint64_t>(flopTexture(entry.board, entry.boardCount)) << TEXTURE_SHIFT;
+
+        for (int s = 0; s < numSeats; s++) {
+            if (filterPlayer && players[s] != filterIndex) continue;
+            const HistorySeat& seat = seats[s];
+            const unsigned bit = 1u << s;
+
+            uint64_t key = players[s] |
+                           static_cast<uint64_t>(positionOf(s, entry.button, numSeats)) << POSITION_SHIFT |
+                           static_cast<uint64_t>(stackBucket(seat.stack, entry.bigBlind)) << STACK_SHIFT |
+                           textureKey;
+            StatsCounters& counters = table[key & groupMask];
+
+            const bool sawFlop = flop && !(foldedPreflop & bit);
+            const bool showdown = sawFlop && live >= 2 && !(seat.flags & HistorySeat::FOLDED);
+            counters.hands++;
+            counters.vpip += (vpip & bit) ? 1 : 0;
+            counters.pfr += (pfr & bit) ? 1 : 0;
+            counters.threeBetChances += (threeBetChances & bit) ? 1 : 0;
+            counters.threeBets += (threeBets & bit) ? 1 : 0;
+            counters.cbetChances += (cbetChance & bit) ? 1 : 0;
+            counters.cbets += (cbet & bit) ? 1 : 0;
+            counters.sawFlop += sawFlop ? 1 : 0;
+            counters.showdowns += showdown ? 1 : 0;
+            counters.showdownsWon += (showdown && seat.collected > 0) ? 1 : 0;
+            counters.netBb += static_cast<double>(seat.collected - seat.invested) / entry.bigBlind;
+        }
+    }
+
+    bool keepHand(const HandLogEntry& entry, const StatsFilter& filter) {
+        if (entry.bigBlind <= 0) return false;
+        const bool tournament = (entry.flags & HandRecord::TOURNAMENT) != 0;
+        if (filter.game == StatsFilter::CASH && tournament) return false;
+        if (filter.game == StatsFilter::TOURNAMENT && !tournament) return false;
+        if (entry.numSeats < filter.minSeats || entry.numSeats > filter.maxSeats) return false;
+        if (filter.from != 0 && entry.timestamp < filter.from) return false;
+        if (filter.to != 0 && entry.timestamp > filter.to) return false;
+        return true;
+    }
+
+    std::string playerLabel(const HandLog& log, uint32_t index) {
+        const uint64_t id = log.getPlayerId(index);
+        auto name = log.getNames().find(id);
+        if (name != log.getNames().end()) return name->second;
+        std::ostringstream oss;
+        oss << "#" << std::hex << std::setw(16) << std::setfill('0') << id;
+        return oss.str();
+    }
+
+    std::string groupLabel(const HandLog& log, StatsGroup group, uint64_t key) {
+        switch (group) {
+            case StatsGroup::PLAYER: return playerLabel(log, static_cast<uint32_t>(key));
+            case StatsGroup::POSITION: return POSITION_NAMES[(key >> POSITION_SHIFT) & 0xF];
+            case StatsGroup::STACK_DEPTH: return STACK_NAMES[(key >> STACK_SHIFT) & 0xF];
+            default: return TEXTURE_NAMES[(key >> TEXTURE_SHIFT) & 0xF];
+        }
+    }
+
+    uint64_t groupBits(StatsGroup group) {
+        switch (group) {
+            case StatsGroup::PLAYER: return 0xFFFFFFFFull;
+            case StatsGroup::POSITION: return 0xFull << POSITION_SHIFT;
+            case StatsGroup::STACK_DEPTH: return 0xFull << STACK_SHIFT;
+            default: return 0xFull << TEXTURE_SHIFT;
+        }
+    }
+}
+
+void StatsCounters::merge(const StatsCounters& other) {
+    hands += other.hands;
+    vpip += other.vpip;
+    pfr += other.pfr;
+    threeBetChances += other.threeBetChances;
+    threeBets += other.threeBets;
+    cbetChances += other.cbetChances;
+    cbets += other.cbets;
+    sawFlop += other.sawFlop;
+    showdowns += other.showdowns;
+    showdownsWon += other.showdownsWon;
+    netBb += other.netBb;
+}
+
+std::string StatsTable::toString() const {
+    std::vector<size_t> widths;
+    for (size_t c = 0; c < columns.size(); c++) {
+        size_t width = std::max<size_t>(columns[c].size(), 5);
+        for (const auto& row : rows) {
+            width = std::max(width, row.labels[c].size());
+        }
+        widths.push_back(width + 2);
+    }
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "=== Player Statistics ===\n";
+    oss << "Hands scanned: " << scannedHands << "   Seat-hands matched: " << total.hands << "   Time: "
+        << std::setprecision(2) << seconds << "s";
+    if (seconds > 0.0) {
+        oss << " (" << bytes / (1024.0 * 1024.0) / seconds << " MB/s)";
+    }
+    oss << std::setprecision(1) << "\n";
+
+    auto line = [&](const std::vector<std::string>& labels, const StatsCounters& c) {
+        for (size_t i = 0; i < labels.size(); i++) {
+            oss << std::left << std::setw(static_cast<int>(widths[i])) << labels[i];
+        }
+        oss << std::right << std::setw(10) << c.hands
+            << std::setw(7) << StatsCounters::percent(c.vpip, c.hands)
+            << std::setw(7) << StatsCounters::percent(c.pfr, c.hands)
+            << std::setw(7) << StatsCounters::percent(c.threeBets, c.threeBetChances)
+            << std::setw(7) << StatsCounters::percent(c.cbets, c.cbetChances)
+            << std::setw(7) << StatsCounters::percent(c.showdowns, c.sawFlop)
+            << std::setw(7) << StatsCounters::percent(c.showdownsWon, c.showdowns)
+            << std::setw(9) << std::setprecision(2) << c.bbPer100() << std::setprecision(1) << "\n";
+    };
+
+    for (size_t i = 0; i < columns.size(); i++) {
+        oss << std::left << std::setw(static_cast<int>(widths[i])) << columns[i];
+    }
+    oss << std::right << std::setw(10) << "Hands" << std::setw(7) << "VPIP" << std::setw(7) << "PFR"
+        << std::setw(7) << "3Bet" << std::setw(7) << "CBet" << std::setw(7) << "WTSD" << std::setw(7) << "W$SD"
+        << std::setw(9) << "bb/100" << "\n";
+    for (const auto& row : rows) {
+        line(row.labels, row.counters);
+    }
+    if (!columns.empty()) {
+        std::vector<std::string> totalLabels(columns.size());
+        totalLabels[0] = "Total";
+        line(totalLabels, total);
+    }
+    return oss.str();
+}
+
+void StatsTable::writeCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+    for (const auto& column : columns) {
+        out << column << ",";
+    }
+    out << "hands,vpip,pfr,three_bet,cbet,wtsd,wsd,bb_per_100\n";
+    out << std::fixed << std::setprecision(2);
+    for (const auto& row : rows) {
+        for (const auto& label : row.labels) {
+            out << label << ",";
+        }
+        const StatsCounters& c = row.counters;
+        out << c.hands << "," << StatsCounters::percent(c.vpip, c.hands) << ","
+            << StatsCounters::percent(c.pfr, c.hands) << ","
+            << StatsCounters::percent(c.threeBets, c.threeBetChances) << ","
+            << StatsCounters::percent(c.cbets, c.cbetChances) << ","
+            << StatsCounters::percent(c.showdowns, c.sawFlop) << ","
+            << StatsCounters::percent(c.showdownsWon, c.showdowns) << "," << c.bbPer100() << "\n";
+    }
+}
+
+PlayerStatsEngine::PlayerStatsEngine(const StatsQuery& statsQuery) : query(statsQuery) {
+}
+
+std::string PlayerStatsEngine::groupName(StatsGroup group) {
+    switch (group) {
+        case StatsGroup::PLAYER: return "Player";
+        case StatsGroup::POSITION: return "Position";
+        case StatsGroup::STACK_DEPTH: return "Stack";
+        default: return "Flop";
+    }
+}
+
+StatsTable PlayerStatsEngine::run(const std::string& logPath,
+                                  const std::function<void(long long, long long)>& progress) const {
+    TraceSpan span("player stats", "job");
+    auto start = std::chrono::steady_clock::now();
+
+    HandLog log(logPath);
+    StatsTable table;
+    table.bytes = std::ifstream(logPath, std::ios::binary | std::ios::ate).tellg();
+    uint64_t groupMask = 0;
+    for (StatsGroup group : query.groupBy) {
+        table.columns.push_back(groupName(group));
+        groupMask |= groupBits(group);
+    }
+
+    // Joueur filtré: son index dans la table des joueurs du journal
+    const bool filterPlayer = !query.filter.player.empty();
+    uint32_t filterIndex = 0;
+    if (filterPlayer) {
+        const uint64_t id = HandRecord::playerId(query.filter.player.data(), query.filter.player.size());
+        while (filterIndex < log.getNumPlayers() && log.getPlayerId(filterIndex) != id) {
+            filterIndex++;
+        }
+        if (filterIndex == log.getNumPlayers()) {
+            table.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return table;
+        }
+    }
+
+    const size_t numBlocks = log.getNumBlocks();
+    const size_t numBatches = (numBlocks + BLOCKS_PER_BATCH - 1) / BLOCKS_PER_BATCH;
+    int numThreads = query.threads > 0
+        ? query.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    numThreads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(numThreads, numBatches)));
+
+    // Une table de compteurs par thread, fusionnées à la fin
+    std::vector<CounterTable> tables(numThreads);
+    std::vector<long long> scanned(numThreads, 0);
+    std::atomic<size_t> next(0);
+    std::mutex progressMutex;
+    long long blocksDone = 0;
+    std::exception_ptr failure;
+
+    auto worker = [&](int t) {
+        try {
+            HandLogEntry entry;
+            HistorySeat seats[HandRecord::MAX_SEATS];
+            HistoryAction actions[HandRecord::MAX_ACTIONS];
+            uint32_t players[HandRecord::MAX_SEATS];
+            size_t batch;
+            while ((batch = next++) < numBatches) {
+                const size_t first = batch * BLOCKS_PER_BATCH;
+                const size_t last = std::min(numBlocks, first + BLOCKS_PER_BATCH);
+                TraceSpan chunk("stats blocks", "chunk", static_cast<int64_t>(first));
+                HandLogCursor cursor(log, first, last);
+                while (cursor.next(entry)) {
+                    scanned[t]++;
+                    if (!keepHand(entry, query.filter)) continue;
+                    entry.decodeSeats(seats, players);
+                    if (filterPlayer && std::find(players, players + entry.numSeats, filterIndex) ==
+                                            players + entry.numSeats) {
+                        continue;
+                    }
+                    entry.decodeActions(actions);
+                    addHand(entry, seats, players, actions, filterPlayer, filterIndex, groupMask, tables[t]);
+                }
+                if (progress) {
+                    std::lock_guard<std::mutex> lock(progressMutex);
+                    blocksDone += static_cast<long long>(last - first);
+                    progress(blocksDone, static_cast<long long>(numBlocks));
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(progressMutex);
+            if (!failure) failure = std::current_exception();
+            next = numBatches;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < numThreads; t++) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    CounterTable& merged = tables[0];
+    for (int t = 1; t < numThreads; t++) {
+        for (const auto& group : tables[t]) {
+            merged[group.first].merge(group.second);
+        }
+        tables[t].clear();
+    }
+    for (long long count : scanned) {
+        table.scannedHands += count;
+    }
+
+    for (const auto& group : merged) {
+        table.total.merge(group.second);
+        if (group.second.hands < query.minHands) continue;
+        StatsRow row;
+        for (StatsGroup dimension : query.groupBy) {
+            row.labels.push_back(groupLabel(log, dimension, group.first));
+        }
+        row.counters = group.second;
+        table.rows.push_back(std::move(row));
+    }
+    std::sort(table.rows.begin(), table.rows.end(), [](const StatsRow& a, const StatsRow& b) {
+        return a.counters.hands != b.counters.hands ? a.counters.hands > b.counters.hands : a.labels < b.labels;
+    });
+    if (query.maxRows > 0 && table.rows.size() > query.maxRows) {
+        table.rows.resize(query.maxRows);
+    }
+
+    table.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return table;
+}
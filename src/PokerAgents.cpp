@@ -0,0 +1,28 @@
+#include "../include/PokerAgents.h"
+#include <stdexcept>
+
+Action CallingStationAgent::act(const BettingState& state) {
+    return state.checkOrCall();
+}
+
+RandomAgent::RandomAgent(double foldFreq, double raiseFreq, unsigned int seed)
+    : foldFrequency(foldFreq), raiseFrequency(raiseFreq), rng(seed), uniform(0.0, 1.0) {
+    if (foldFreq < 0.0 || raiseFreq < 0.0 || foldFreq + raiseFreq > 1.0) {
+        throw std::invalid_argument("Invalid action frequencies");
+    }
+}
+
+Action RandomAgent::act(const BettingState& state) {
+    double r = uniform(rng);
+
+    if (state.toCall > 0 && r < foldFrequency) {
+        return Action::fold();
+    }
+    if (state.canRaise && uniform(rng) < raiseFrequency) {
+        // Entre la mise minimale et la taille du pot (après avoir payé)
+        int potAfterCall = state.pot + state.toCall;
+        int target = state.currentBet + static_cast<int>(potAfterCall * (0.5 + 0.5 * uniform(rng)));
+        return state.betOrRaise(target);
+    }
+    return state.checkOrCall();
+}
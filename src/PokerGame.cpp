@@ -2,19 +2,47 @@
 #include "HandEvaluator.h"
 #include <iostream>
 #include <algorithm>
+#include <stdexcept>
+
+Action BettingState::betOrRaise(int total) const {
+    if (!canRaise) {
+        return checkOrCall();
+    }
+    total = std::max(minRaiseTo, std::min(total, maxRaiseTo));
+    return currentBet > 0 ? Action::raiseTo(total) : Action::bet(total);
+}
 
 PokerGame::PokerGame(int numPlayers, int sb, int bb, int startingStack)
-    : smallBlind(sb), bigBlind(bb), dealerPosition(0), currentPhase(GamePhase::PRE_FLOP), currentPlayerIndex(0) {
-    
-    if (numPlayers < 2 || numPlayers > 9) {
+    : currentPhase(GamePhase::PRE_FLOP), dealerPosition(0), smallBlind(sb), bigBlind(bb), currentPlayerIndex(0),
+      silent(false), lastRaiseSize(bb), handDealer(0) {
+
+    if (numPlayers < 2 || numPlayers > MAX_PLAYERS) {
         throw std::invalid_argument("Number of players must be between 2 and 9");
     }
-    
+    if (sb <= 0 || bb < sb) {
+        throw std::invalid_argument("Invalid blinds");
+    }
+
     // Create players
     for (int i = 0; i < numPlayers; i++) {
         std::string name = "Player " + std::to_string(i + 1);
         players.push_back(new Player(name, startingStack, i));
     }
+
+    agents.assign(numPlayers, nullptr);
+    dealtCards.assign(2 * numPlayers, Card(Rank::TWO, Suit::HEARTS));
+    dealScratch.reserve(2);
+    board.reserve(5);
+    history.reserve(64);
+    std::fill(needsToAct, needsToAct + MAX_PLAYERS, false);
+    std::fill(canReopen, canReopen + MAX_PLAYERS, false);
+    std::fill(handStartStacks, handStartStacks + MAX_PLAYERS, 0);
+    std::fill(handWinnings, handWinnings + MAX_PLAYERS, 0);
+    blindSeats[0] = blindSeats[1] = 0;
+    for (int i = 0; i < numPlayers; i++) {
+        std::string name = players[i]->getName();
+        playerIds[i] = HandRecord::playerId(name.data(), name.size());
+    }
 }
 
 PokerGame::~PokerGame() {
@@ -23,32 +51,66 @@ PokerGame::~PokerGame() {
     }
 }
 
+void PokerGame::setAgent(int seat, PokerAgent* agent) {
+    agents.at(seat) = agent;
+}
+
+void PokerGame::setDealerPosition(int seat) {
+    if (seat < 0 || seat >= static_cast<int>(players.size())) {
+        throw std::out_of_range("Invalid seat");
+    }
+    dealerPosition = seat;
+}
+
 void PokerGame::startNewHand() {
     // Reset
     deck.reset();
     board.clear();
     potManager.reset();
+    history.clear();
     currentPhase = GamePhase::PRE_FLOP;
-    
-    // Reset les joueurs
+
+    // Reset les joueurs (sans jetons = ne joue pas la main)
+    int seated = 0;
     for (auto* player : players) {
         player->resetForNewHand();
+        if (player->getStack() > 0) {
+            seated++;
+        } else {
+            player->fold();
+        }
+    }
+
+    if (seated < 2) {
+        throw std::runtime_error("Not enough players with chips to deal a hand");
+    }
+
+    if (players[dealerPosition]->getStack() == 0) {
+        dealerPosition = nextSeatWithChips(dealerPosition);
+    }
+
+    handDealer = dealerPosition;
+    for (size_t seat = 0; seat < players.size(); seat++) {
+        handStartStacks[seat] = players[seat]->getStack();
+        handWinnings[seat] = 0;
     }
-    
+
     // Poster les blinds
     postBlinds();
-    
+
     // Distribuer les cartes
     dealHoleCards();
 }
 
 void PokerGame::dealHoleCards() {
-    for (auto* player : players) {
-        if (player->isActive() && player->getStack() > 0) {
-            std::vector<Card> cards;
-            cards.push_back(deck.draw());
-            cards.push_back(deck.draw());
-            player->setHoleCards(cards);
+    for (size_t i = 0; i < players.size(); i++) {
+        if (players[i]->isActive()) {
+            dealScratch.clear();
+            dealScratch.push_back(deck.draw());
+            dealScratch.push_back(deck.draw());
+            dealtCards[2 * i] = dealScratch[0];
+            dealtCards[2 * i + 1] = dealScratch[1];
+            players[i]->setHoleCards(dealScratch);
         }
     }
 }
@@ -57,13 +119,13 @@ void PokerGame::dealFlop() {
     if (currentPhase != GamePhase::PRE_FLOP) {
         throw std::runtime_error("Invalid phase for flop");
     }
-    
+
     deck.draw(); // Burn card
-    
+
     for (int i = 0; i < 3; i++) {
         board.push_back(deck.draw());
     }
-    
+
     currentPhase = GamePhase::FLOP;
 }
 
@@ -71,91 +133,401 @@ void PokerGame::dealTurn() {
     if (currentPhase != GamePhase::FLOP) {
         throw std::runtime_error("Phase invalide pour le turn");
     }
-    
+
     deck.draw(); // Burn card
     board.push_back(deck.draw());
     currentPhase = GamePhase::TURN;
 }
 
 void PokerGame::dealRiver() {
-    if (currentPhase != GamePhase::RIVER) {
+    if (currentPhase != GamePhase::TURN) {
         throw std::runtime_error("Phase invalide pour la river");
     }
-    
+
     deck.draw(); // Burn card
     board.push_back(deck.draw());
     currentPhase = GamePhase::RIVER;
 }
 
 void PokerGame::bettingRound() {
-    // Simplification: cette méthode devrait gérer les actions des joueurs
-    // Pour l'instant, c'est un placeholder
+    const int numSeats = static_cast<int>(players.size());
+
+    // Nouveau tour d'enchères (pré-flop, les blinds comptent comme mises)
+    if (currentPhase != GamePhase::PRE_FLOP) {
+        for (auto* player : players) {
+            player->resetBet();
+        }
+        potManager.setCurrentBet(0);
+        currentPlayerIndex = (dealerPosition + 1) % numSeats;
+    }
+
+    lastRaiseSize = bigBlind;
+    for (int s = 0; s < numSeats; s++) {
+        needsToAct[s] = players[s]->canAct();
+        canReopen[s] = true;
+    }
+
+    while (playersInHand() > 1 && !isRoundComplete()) {
+        int seat = currentPlayerIndex;
+        while (!(needsToAct[seat] && players[seat]->canAct())) {
+            seat = (seat + 1) % numSeats;
+        }
+        currentPlayerIndex = (seat + 1) % numSeats;
+
+        // Seul joueur avec des jetons et rien à payer: plus personne contre qui miser
+        int canActCount = 0;
+        for (auto* player : players) {
+            if (player->canAct()) canActCount++;
+        }
+        if (canActCount == 1 && players[seat]->getCurrentBet() >= potManager.getCurrentBet()) {
+            needsToAct[seat] = false;
+            continue;
+        }
+
+        BettingState state = makeBettingState(seat);
+        Action action = agents[seat] ? agents[seat]->act(state) : state.checkOrCall();
+        applyAction(seat, action);
+    }
+
+    potManager.calculatePots(players);
+}
+
+void PokerGame::applyAction(int seat, const Action& action) {
+    if (seat < 0 || seat >= static_cast<int>(players.size())) {
+        throw std::out_of_range("Invalid seat");
+    }
+
+    Player* player = players[seat];
+    if (!player->canAct()) {
+        throw std::invalid_argument(player->getName() + " cannot act");
+    }
+
+    const int currentBet = potManager.getCurrentBet();
+    const int playerBet = player->getCurrentBet();
+    const int maxTotal = playerBet + player->getStack();
+
+    ActionType type = action.type;
+    int total = action.amount;
+
+    if (type == ActionType::ALL_IN) {
+        total = maxTotal;
+        if (maxTotal <= currentBet) {
+            type = ActionType::CALL;
+        } else {
+            type = currentBet > 0 ? ActionType::RAISE : ActionType::BET;
+        }
+    }
+
+    switch (type) {
+        case ActionType::FOLD:
+            player->fold();
+            break;
+
+        case ActionType::CHECK:
+            if (currentBet > playerBet) {
+                throw std::invalid_argument("Cannot check facing a bet");
+            }
+            break;
+
+        case ActionType::CALL:
+            if (currentBet <= playerBet) {
+                throw std::invalid_argument("Nothing to call, check instead");
+            }
+            commitChips(player, std::min(currentBet, maxTotal) - playerBet);
+            break;
+
+        case ActionType::BET:
+        case ActionType::RAISE: {
+            if (type == ActionType::BET && currentBet > 0) {
+                throw std::invalid_argument("Cannot bet facing a bet, raise instead");
+            }
+            if (type == ActionType::RAISE && currentBet == 0) {
+                throw std::invalid_argument("Nothing to raise, bet instead");
+            }
+            if (!canReopen[seat]) {
+                throw std::invalid_argument("Betting is not reopened for this player");
+            }
+            if (total <= currentBet || total > maxTotal) {
+                throw std::invalid_argument("Bet amount out of range");
+            }
+
+            int increment = total - currentBet;
+            if (increment < lastRaiseSize && total < maxTotal) {
+                throw std::invalid_argument("Bet below the minimum raise");
+            }
+
+            commitChips(player, total - playerBet);
+            potManager.setCurrentBet(total);
+
+            // Une relance complète rouvre les enchères, un tapis trop court non
+            bool fullRaise = increment >= lastRaiseSize;
+            if (fullRaise) {
+                lastRaiseSize = increment;
+            }
+            for (size_t s = 0; s < players.size(); s++) {
+                if (static_cast<int>(s) != seat && players[s]->canAct()) {
+                    needsToAct[s] = true;
+                    if (fullRaise) canReopen[s] = true;
+                }
+            }
+            break;
+        }
+
+        case ActionType::ALL_IN:
+            break;
+    }
+
+    needsToAct[seat] = false;
+    canReopen[seat] = false;
+
+    ActionRecord record;
+    record.seat = static_cast<uint8_t>(seat);
+    record.phase = currentPhase;
+    record.type = type;
+    record.amount = player->getCurrentBet();
+    record.allIn = player->getStatus() == PlayerStatus::ALL_IN;
+    history.push_back(record);
+
+    if (!silent) {
+        std::cout << player->getName() << ": ";
+        switch (type) {
+            case ActionType::FOLD:  std::cout << "se couche"; break;
+            case ActionType::CHECK: std::cout << "check"; break;
+            case ActionType::CALL:  std::cout << "suit (" << record.amount << ")"; break;
+            case ActionType::BET:   std::cout << "mise " << record.amount; break;
+            default:                std::cout << "relance a " << record.amount; break;
+        }
+        if (record.allIn) std::cout << " - tapis";
+        std::cout << std::endl;
+    }
 }
 
 void PokerGame::showdown() {
-    auto activePlayers = getActivePlayers();
-    
-    if (activePlayers.empty()) {
+    potManager.calculatePots(players);
+
+    int remaining = playersInHand();
+    if (remaining == 0) {
         return;
     }
-    
+
     // Si un seul joueur actif, il gagne
-    if (activePlayers.size() == 1) {
+    if (remaining == 1) {
         int pot = potManager.getTotalPot();
-        activePlayers[0]->addChips(pot);
-        std::cout << activePlayers[0]->getName() << " remporte le pot de " << pot << " jetons!" << std::endl;
+        for (size_t seat = 0; seat < players.size(); seat++) {
+            Player* player = players[seat];
+            if (player->isActive()) {
+                player->addChips(pot);
+                handWinnings[seat] = pot;
+                if (!silent) {
+                    std::cout << player->getName() << " remporte le pot de " << pot << " jetons!" << std::endl;
+                }
+            }
+        }
+        currentPhase = GamePhase::SHOWDOWN;
         return;
     }
-    
-    // Évaluer les mains
-    std::vector<std::pair<Player*, HandValue>> playerHands;
-    
-    for (auto* player : activePlayers) {
-        std::vector<Card> fullHand = player->getHoleCards();
-        fullHand.insert(fullHand.end(), board.begin(), board.end());
-        
-        HandValue hand = HandEvaluator::evaluate(fullHand);
-        playerHands.push_back({player, hand});
-        
-        std::cout << player->getName() << " a: " << hand.toString() << std::endl;
-    }
-    
-    // Distribuer les pots
-    potManager.distributePots(playerHands);
-    
+
+    // Tapis avant la river: distribuer le reste du board
+    if (currentPhase == GamePhase::PRE_FLOP) dealFlop();
+    if (currentPhase == GamePhase::FLOP) dealTurn();
+    if (currentPhase == GamePhase::TURN) dealRiver();
+
+    uint8_t cards[7];
+    for (int i = 0; i < 5; i++) {
+        cards[2 + i] = static_cast<uint8_t>(board[i].toIndex());
+    }
+
+    // Évaluer les mains encore en jeu
+    const int numSeats = static_cast<int>(players.size());
+    int scores[MAX_PLAYERS] = {0};
+    for (int seat = 0; seat < numSeats; seat++) {
+        Player* player = players[seat];
+        if (!player->isActive()) continue;
+
+        cards[0] = static_cast<uint8_t>(dealtCards[2 * seat].toIndex());
+        cards[1] = static_cast<uint8_t>(dealtCards[2 * seat + 1].toIndex());
+        scores[seat] = HandEvaluator::evaluateScore(cards, 7);
+
+        if (!silent) {
+            std::vector<Card> fullHand = player->getHoleCards();
+            fullHand.insert(fullHand.end(), board.begin(), board.end());
+            std::cout << player->getName() << " a: " << HandEvaluator::evaluate(fullHand).toString() << std::endl;
+        }
+    }
+
+    // Distribuer les pots (jetons impairs à gauche du donneur)
+    int winnings[MAX_PLAYERS];
+    potManager.distributePots(scores, (dealerPosition + 1) % numSeats, winnings);
+    for (int seat = 0; seat < numSeats; seat++) {
+        if (winnings[seat] > 0) {
+            players[seat]->addChips(winnings[seat]);
+        }
+        handWinnings[seat] = winnings[seat];
+    }
+
     currentPhase = GamePhase::SHOWDOWN;
 }
 
 void PokerGame::playHand() {
     startNewHand();
-    
-    std::cout << "=== Nouvelle Main ===" << std::endl;
-    displayGameState();
-    
+
+    if (!silent) {
+        std::cout << "=== Nouvelle Main ===" << std::endl;
+        displayGameState();
+    }
+
     // Pre-flop
     bettingRound();
-    
+
     // Flop
-    dealFlop();
-    std::cout << "\n=== FLOP ===" << std::endl;
-    displayGameState();
-    bettingRound();
-    
+    if (playersInHand() > 1) {
+        dealFlop();
+        if (!silent) {
+            std::cout << "\n=== FLOP ===" << std::endl;
+            displayGameState();
+        }
+        bettingRound();
+    }
+
     // Turn
-    dealTurn();
-    std::cout << "\n=== TURN ===" << std::endl;
-    displayGameState();
-    bettingRound();
-    
+    if (playersInHand() > 1) {
+        dealTurn();
+        if (!silent) {
+            std::cout << "\n=== TURN ===" << std::endl;
+            displayGameState();
+        }
+        bettingRound();
+    }
+
     // River
-    dealRiver();
-    std::cout << "\n=== RIVER ===" << std::endl;
-    displayGameState();
-    bettingRound();
-    
+    if (playersInHand() > 1) {
+        dealRiver();
+        if (!silent) {
+            std::cout << "\n=== RIVER ===" << std::endl;
+            displayGameState();
+        }
+        bettingRound();
+    }
+
     // Showdown
-    std::cout << "\n=== SHOWDOWN ===" << std::endl;
+    if (!silent) {
+        std::cout << "\n=== SHOWDOWN ===" << std::endl;
+    }
     showdown();
+
+    moveDealer();
+}
+
+bool PokerGame::exportHand(HandRecord& record, uint64_t handId) const {
+    record.clear();
+    record.handId = handId;
+    record.smallBlind = smallBlind;
+    record.bigBlind = bigBlind;
+
+    // Sièges servis (ceux sans jetons en début de main sont absents)
+    int recordSeat[MAX_PLAYERS];
+    int live = 0;
+    for (size_t seat = 0; seat < players.size(); seat++) {
+        recordSeat[seat] = -1;
+        if (handStartStacks[seat] <= 0) continue;
+        if (players[seat]->getStatus() != PlayerStatus::FOLDED) live++;
+
+        recordSeat[seat] = record.numSeats;
+        HistorySeat& out = record.seats[record.numSeats++];
+        out.playerId = playerIds[seat];
+        out.stack = handStartStacks[seat];
+        out.invested = players[seat]->getTotalBetInHand();
+        out.collected = handWinnings[seat];
+        out.seatNumber = static_cast<uint8_t>(seat + 1);
+        out.cards[0] = static_cast<uint8_t>(dealtCards[2 * seat].toIndex());
+        out.cards[1] = static_cast<uint8_t>(dealtCards[2 * seat + 1].toIndex());
+        out.flags = 0;
+        if (players[seat]->getStatus() == PlayerStatus::FOLDED) out.flags |= HistorySeat::FOLDED;
+        if (players[seat]->getStatus() == PlayerStatus::ALL_IN) out.flags |= HistorySeat::ALL_IN;
+    }
+    for (int s = 0; s < record.numSeats && live > 1; s++) {
+        if (!(record.seats[s].flags & HistorySeat::FOLDED)) record.seats[s].flags |= HistorySeat::SHOWED;
+    }
+    record.button = static_cast<uint8_t>(recordSeat[handDealer]);
+
+    record.boardCount = static_cast<uint8_t>(board.size());
+    for (size_t i = 0; i < board.size(); i++) {
+        record.board[i] = static_cast<uint8_t>(board[i].toIndex());
+    }
+
+    // Mise non suivie: la part au-dessus de la deuxième plus grosse mise est rendue (pot à un seul joueur)
+    int topSeat = -1;
+    int top = 0, second = 0;
+    for (size_t seat = 0; seat < players.size(); seat++) {
+        if (recordSeat[seat] < 0) continue;
+        const int invested = players[seat]->getTotalBetInHand();
+        if (invested > top) {
+            second = top;
+            top = invested;
+            topSeat = static_cast<int>(seat);
+        } else if (invested > second) {
+            second = invested;
+        }
+    }
+    const int uncalled = topSeat >= 0 ? top - second : 0;
+    if (uncalled > 0) {
+        HistorySeat& out = record.seats[recordSeat[topSeat]];
+        out.invested -= uncalled;
+        out.collected -= uncalled;
+    }
+
+    if (history.size() + 3 > static_cast<size_t>(HandRecord::MAX_ACTIONS)) {
+        return false;
+    }
+
+    // Blindes, puis les actions avec le montant ajouté (l'historique donne la mise totale du tour)
+    int streetBet[MAX_PLAYERS] = {0};
+    for (int b = 0; b < 2; b++) {
+        const int seat = blindSeats[b];
+        const int amount = std::min(b == 0 ? smallBlind : bigBlind, handStartStacks[seat]);
+        HistoryAction& action = record.actions[record.numActions++];
+        action.seat = static_cast<uint8_t>(recordSeat[seat]);
+        action.street = static_cast<uint8_t>(GamePhase::PRE_FLOP);
+        action.type = b == 0 ? HistoryActionType::POST_SMALL_BLIND : HistoryActionType::POST_BIG_BLIND;
+        action.allIn = amount == handStartStacks[seat];
+        action.amount = amount;
+        streetBet[seat] = amount;
+    }
+
+    GamePhase phase = GamePhase::PRE_FLOP;
+    for (const auto& applied : history) {
+        if (applied.phase != phase) {
+            phase = applied.phase;
+            std::fill(streetBet, streetBet + MAX_PLAYERS, 0);
+        }
+
+        HistoryAction& action = record.actions[record.numActions++];
+        action.seat = static_cast<uint8_t>(recordSeat[applied.seat]);
+        action.street = static_cast<uint8_t>(applied.phase);
+        action.allIn = applied.allIn;
+        action.amount = 0;
+        switch (applied.type) {
+            case ActionType::FOLD: action.type = HistoryActionType::FOLD; break;
+            case ActionType::CHECK: action.type = HistoryActionType::CHECK; break;
+            case ActionType::CALL: action.type = HistoryActionType::CALL; break;
+            case ActionType::BET: action.type = HistoryActionType::BET; break;
+            default: action.type = HistoryActionType::RAISE; break;
+        }
+        if (applied.type != ActionType::FOLD && applied.type != ActionType::CHECK) {
+            action.amount = applied.amount - streetBet[applied.seat];
+            streetBet[applied.seat] = applied.amount;
+        }
+    }
+
+    if (uncalled > 0) {
+        HistoryAction& action = record.actions[record.numActions++];
+        action.seat = static_cast<uint8_t>(recordSeat[topSeat]);
+        action.street = static_cast<uint8_t>(phase);
+        action.type = HistoryActionType::UNCALLED;
+        action.allIn = false;
+        action.amount = uncalled;
+    }
+    return true;
 }
 
 void PokerGame::displayGameState() const {
@@ -168,21 +540,21 @@ void PokerGame::displayGameState() const {
         }
     }
     std::cout << std::endl;
-    
+
     std::cout << potManager.toString() << std::endl;
-    
+
     std::cout << "\nJoueurs:" << std::endl;
     for (const auto* player : players) {
-        std::cout << "  " << player->getName() << " - Stack: " << player->getStack() 
+        std::cout << "  " << player->getName() << " - Stack: " << player->getStack()
                   << " jetons";
-        
+
         if (player->hasCards()) {
             std::cout << " - Cartes: ";
             for (const auto& card : player->getHoleCards()) {
                 std::cout << "[" << card.toString() << "] ";
             }
         }
-        
+
         std::cout << std::endl;
     }
 }
@@ -198,19 +570,27 @@ std::vector<Player*> PokerGame::getActivePlayers() const {
 }
 
 void PokerGame::postBlinds() {
-    int sbPos = (dealerPosition + 1) % players.size();
-    int bbPos = (dealerPosition + 2) % players.size();
-    
-    players[sbPos]->bet(smallBlind);
-    players[bbPos]->bet(bigBlind);
-    
-    potManager.addToPot(players[sbPos], smallBlind);
-    potManager.addToPot(players[bbPos], bigBlind);
+    int seated = 0;
+    for (auto* player : players) {
+        if (player->getStack() > 0) seated++;
+    }
+
+    // En tête-à-tête, le donneur poste la petite blind
+    int sbPos = seated == 2 ? dealerPosition : nextSeatWithChips(dealerPosition);
+    int bbPos = nextSeatWithChips(sbPos);
+
+    blindSeats[0] = sbPos;
+    blindSeats[1] = bbPos;
+    commitChips(players[sbPos], std::min(smallBlind, players[sbPos]->getStack()));
+    commitChips(players[bbPos], std::min(bigBlind, players[bbPos]->getStack()));
     potManager.setCurrentBet(bigBlind);
+
+    currentPlayerIndex = (bbPos + 1) % players.size();
 }
 
 void PokerGame::moveDealer() {
-    dealerPosition = (dealerPosition + 1) % players.size();
+    int next = nextSeatWithChips(dealerPosition);
+    dealerPosition = next >= 0 ? next : (dealerPosition + 1) % players.size();
 }
 
 int PokerGame::getNextActivePlayer(int startFrom) {
@@ -223,18 +603,67 @@ int PokerGame::getNextActivePlayer(int startFrom) {
     return -1;
 }
 
+int PokerGame::nextSeatWithChips(int startFrom) const {
+    for (int i = 1; i <= static_cast<int>(players.size()); i++) {
+        int idx = (startFrom + i) % players.size();
+        if (players[idx]->getStack() > 0) {
+            return idx;
+        }
+    }
+    return -1;
+}
+
 bool PokerGame::isRoundComplete() {
-    int activePlayers = 0;
-    int currentBet = potManager.getCurrentBet();
-    
-    for (auto* player : players) {
-        if (player->isActive()) {
-            activePlayers++;
-            if (player->canAct() && player->getCurrentBet() < currentBet) {
-                return false;
-            }
+    for (size_t s = 0; s < players.size(); s++) {
+        if (needsToAct[s] && players[s]->canAct()) {
+            return false;
         }
     }
-    
-    return activePlayers > 0;
+    return true;
+}
+
+int PokerGame::playersInHand() const {
+    int count = 0;
+    for (auto* player : players) {
+        if (player->isActive()) count++;
+    }
+    return count;
+}
+
+BettingState PokerGame::makeBettingState(int seat) const {
+    const Player* player = players[seat];
+    const int currentBet = potManager.getCurrentBet();
+    const int maxTotal = player->getCurrentBet() + player->getStack();
+
+    return BettingState{
+        seat,
+        currentPhase,
+        static_cast<int>(players.size()),
+        dealerPosition,
+        bigBlind,
+        &dealtCards[2 * seat],
+        board,
+        history,
+        potManager.getTotalPot(),
+        currentBet,
+        player->getCurrentBet(),
+        player->getStack(),
+        std::max(0, currentBet - player->getCurrentBet()),
+        canReopen[seat] && maxTotal > currentBet,
+        std::min(currentBet + lastRaiseSize, maxTotal),
+        maxTotal,
+        playersInHand()
+    };
+}
+
+void PokerGame::commitChips(Player* player, int chips) {
+    if (chips <= 0) return;
+
+    if (chips >= player->getStack()) {
+        chips = player->getStack();
+        player->allIn();
+    } else {
+        player->bet(chips);
+    }
+    potManager.addToPot(player, chips);
 }
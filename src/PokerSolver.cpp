@@ -1,8 +1,15 @@
 #include "../include/PokerSolver.h"
+#include "../include/Arena.h"
+#include "../include/ICMCalculator.h"
+#include "../include/SolverStats.h"
+#include "../include/Trace.h"
 #include <sstream>
 #include <iomanip>
 #include <random>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
 
 std::string EquityResult::toString() const {
     std::ostringstream oss;
@@ -20,7 +27,11 @@ std::string DecisionResult::toString() const {
     oss << "=== Decision Analysis ===" << std::endl;
     oss << "Equity:     " << equity << "%" << std::endl;
     oss << "Pot Odds:   " << potOdds << "%" << std::endl;
-    oss << "EV:         " << expectedValue << " chips" << std::endl;
+    if (prizeEquity) {
+        oss << "$EV:        " << expectedValue << " (prize equity vs fold)" << std::endl;
+    } else {
+        oss << "EV:         " << expectedValue << " chips" << std::endl;
+    }
     oss << "Decision:   " << (shouldCall ? "CALL (Profitable)" : "FOLD (Not profitable)") << std::endl;
     oss << "Reason:     " << reasoning << std::endl;
     return oss.str();
@@ -46,34 +57,122 @@ EquityResult PokerSolver::calculateEquity(
         throw std::invalid_argument("Maximum 5 cards on the board");
     }
     
-    EquityResult result;
-    result.simulations = simulations;
+    if (numOpponents < 0 || 2 + 5 + 2 * numOpponents > 52) {
+        throw std::invalid_argument("Invalid number of opponents");
+    }
+    
+    TraceSpan span("calculateEquity", "chunk", simulations);
+    
+    // Instrumentation lue une fois par appel: la boucle sans compteurs reste inchangée
+    const bool instrumented = Instrumentation::enabled();
+    const uint64_t setupStart = instrumented ? Instrumentation::ticks() : 0;
+    
+    // Paquet restant (indices denses), sans les cartes connues
+    uint8_t hero[7];
+    uint8_t opponent[7];
+    bool dead[52] = {false};
+    hero[0] = static_cast<uint8_t>(holeCards[0].toIndex());
+    hero[1] = static_cast<uint8_t>(holeCards[1].toIndex());
+    dead[hero[0]] = dead[hero[1]] = true;
+    const int boardSize = static_cast<int>(board.size());
+    for (int i = 0; i < boardSize; i++) {
+        hero[2 + i] = opponent[2 + i] = static_cast<uint8_t>(board[i].toIndex());
+        dead[hero[2 + i]] = true;
+    }
+    uint8_t deck[52];
+    int remaining = 0;
+    for (int c = 0; c < 52; c++) {
+        if (!dead[c]) deck[remaining++] = static_cast<uint8_t>(c);
+    }
+    
+    std::mt19937 rng(nextSeed());
+    TrialSetup setup{deck, remaining, hero, opponent, boardSize, numOpponents};
+    if (!instrumented) {
+        return runTrials<false>(setup, simulations, rng, nullptr);
+    }
+    
+    uint64_t phaseTicks[SolverStats::PHASE_COUNT] = {0};
+    phaseTicks[static_cast<int>(SolverPhase::SETUP)] = Instrumentation::ticks() - setupStart;
+    EquityResult result = runTrials<true>(setup, simulations, rng, phaseTicks);
+    for (int p = 0; p < SolverStats::PHASE_COUNT; p++) {
+        Instrumentation::addPhase(static_cast<SolverPhase>(p), phaseTicks[p]);
+    }
+    Instrumentation::addQuery(simulations, static_cast<uint64_t>(simulations) * (1 + numOpponents));
+    return result;
+}
+
+template <bool Timed>
+EquityResult PokerSolver::runTrials(const TrialSetup& setup, int simulations, std::mt19937& rng, uint64_t* phaseTicks) {
+    uint8_t* deck = setup.deck;
+    uint8_t* hero = setup.hero;
+    uint8_t* opponent = setup.opponent;
+    const int remaining = setup.remaining;
+    const int boardSize = setup.boardSize;
+    const int numOpponents = setup.numOpponents;
+    const int missingBoard = 5 - boardSize;
+    const int drawn = missingBoard + 2 * numOpponents;
     
     int wins = 0;
     int ties = 0;
     int losses = 0;
+    uint64_t dealTicks = 0;
+    uint64_t evaluateTicks = 0;
+    uint64_t aggregateTicks = 0;
+    uint64_t mark = Timed ? Instrumentation::ticks() : 0;
     
-    // Cartes mortes (connues)
-    std::vector<Card> deadCards = holeCards;
-    deadCards.insert(deadCards.end(), board.begin(), board.end());
-    
-    // Effectuer les simulations
+    // Effectuer les simulations: Fisher-Yates partiel, le paquet reste une permutation d'un tirage à l'autre
     for (int i = 0; i < simulations; i++) {
-        int outcome = simulateHand(holeCards, board, numOpponents, deadCards);
+        for (int d = 0; d < drawn; d++) {
+            int j = d + static_cast<int>(rng() % static_cast<unsigned>(remaining - d));
+            std::swap(deck[d], deck[j]);
+        }
+        for (int b = 0; b < missingBoard; b++) {
+            hero[2 + boardSize + b] = opponent[2 + boardSize + b] = deck[b];
+        }
+        if (Timed) {
+            const uint64_t now = Instrumentation::ticks();
+            dealTicks += now - mark;
+            mark = now;
+        }
+        
+        const int heroScore = HandEvaluator::evaluateScore(hero, 7);
+        int bestOpponent = -1;
+        for (int o = 0; o < numOpponents; o++) {
+            opponent[0] = deck[missingBoard + 2 * o];
+            opponent[1] = deck[missingBoard + 2 * o + 1];
+            bestOpponent = std::max(bestOpponent, HandEvaluator::evaluateScore(opponent, 7));
+        }
+        if (Timed) {
+            const uint64_t now = Instrumentation::ticks();
+            evaluateTicks += now - mark;
+            mark = now;
+        }
         
-        if (outcome > 0) {
+        if (heroScore > bestOpponent) {
             wins++;
-        } else if (outcome == 0) {
+        } else if (heroScore == bestOpponent) {
             ties++;
         } else {
             losses++;
         }
+        if (Timed) {
+            const uint64_t now = Instrumentation::ticks();
+            aggregateTicks += now - mark;
+            mark = now;
+        }
     }
     
+    EquityResult result;
+    result.simulations = simulations;
     result.winRate = (wins * 100.0) / simulations;
     result.tieRate = (ties * 100.0) / simulations;
     result.loseRate = (losses * 100.0) / simulations;
     
+    if (Timed) {
+        phaseTicks[static_cast<int>(SolverPhase::DEAL)] += dealTicks;
+        phaseTicks[static_cast<int>(SolverPhase::EVALUATE)] += evaluateTicks;
+        phaseTicks[static_cast<int>(SolverPhase::AGGREGATE)] += aggregateTicks + (Instrumentation::ticks() - mark);
+    }
     return result;
 }
 
@@ -87,64 +186,98 @@ EquityResult PokerSolver::calculateEquityVsHands(
         simulations = defaultSimulations;
     }
     
-    EquityResult result;
-    result.simulations = simulations;
+    if (holeCards.size() != 2) {
+        throw std::invalid_argument("Exactly 2 hole cards required");
+    }
     
-    int wins = 0;
-    int ties = 0;
-    int losses = 0;
+    if (board.size() > 5) {
+        throw std::invalid_argument("Maximum 5 cards on the board");
+    }
     
-    // Cartes mortes
-    std::vector<Card> deadCards = holeCards;
-    deadCards.insert(deadCards.end(), board.begin(), board.end());
     for (const auto& oppHand : opponentHands) {
-        deadCards.insert(deadCards.end(), oppHand.begin(), oppHand.end());
+        if (oppHand.size() != 2) {
+            throw std::invalid_argument("Exactly 2 cards per opponent hand");
+        }
+    }
+    
+    TraceSpan span("calculateEquityVsHands", "chunk", simulations);
+    
+    // Données de travail dans l'arène du thread, rendues d'un coup à la fin de la requête
+    Arena& arena = Arena::forThread();
+    Arena::Scope scratch(arena);
+    
+    // Mains à 7 cartes (indices denses), le héros d'abord, tableau connu déjà placé
+    const int numHands = 1 + static_cast<int>(opponentHands.size());
+    uint8_t* hands = arena.allocateArray<uint8_t>(7 * numHands);
+    bool dead[52] = {false};
+    for (int h = 0; h < numHands; h++) {
+        const std::vector<Card>& cards = h == 0 ? holeCards : opponentHands[h - 1];
+        for (int c = 0; c < 2; c++) {
+            hands[7 * h + c] = static_cast<uint8_t>(cards[c].toIndex());
+            dead[hands[7 * h + c]] = true;
+        }
+    }
+    const int boardSize = static_cast<int>(board.size());
+    for (int i = 0; i < boardSize; i++) {
+        const uint8_t card = static_cast<uint8_t>(board[i].toIndex());
+        dead[card] = true;
+        for (int h = 0; h < numHands; h++) {
+            hands[7 * h + 2 + i] = card;
+        }
+    }
+    uint8_t* deck = arena.allocateArray<uint8_t>(52);
+    int remaining = 0;
+    for (int c = 0; c < 52; c++) {
+        if (!dead[c]) deck[remaining++] = static_cast<uint8_t>(c);
+    }
+    
+    std::mt19937 rng(nextSeed());
+    const int missingBoard = 5 - boardSize;
+    if (remaining < missingBoard) {
+        throw std::invalid_argument("Not enough cards left to complete the board");
     }
     
+    int wins = 0;
+    int ties = 0;
+    int losses = 0;
+    
     for (int i = 0; i < simulations; i++) {
-        // Créer un deck sans les cartes mortes
-        Deck deck;
-        deck.removeCards(deadCards);
-        
-        // Compléter le board si nécessaire
-        std::vector<Card> fullBoard = board;
-        while (fullBoard.size() < 5) {
-            fullBoard.push_back(deck.draw());
+        // Compléter le board: Fisher-Yates partiel sur le paquet restant
+        for (int d = 0; d < missingBoard; d++) {
+            int j = d + static_cast<int>(rng() % static_cast<unsigned>(remaining - d));
+            std::swap(deck[d], deck[j]);
+            for (int h = 0; h < numHands; h++) {
+                hands[7 * h + 2 + boardSize + d] = deck[d];
+            }
         }
         
         // Évaluer toutes les mains
-        std::vector<Card> heroFullHand = holeCards;
-        heroFullHand.insert(heroFullHand.end(), fullBoard.begin(), fullBoard.end());
-        HandValue heroHand = HandEvaluator::evaluate(heroFullHand);
-        
-        HandValue bestOpponentHand;
-        bool firstOpp = true;
-        
-        for (const auto& oppCards : opponentHands) {
-            std::vector<Card> oppFullHand = oppCards;
-            oppFullHand.insert(oppFullHand.end(), fullBoard.begin(), fullBoard.end());
-            HandValue oppHand = HandEvaluator::evaluate(oppFullHand);
-            
-            if (firstOpp || oppHand > bestOpponentHand) {
-                bestOpponentHand = oppHand;
-                firstOpp = false;
-            }
+        const int heroScore = HandEvaluator::evaluateScore(hands, 7);
+        int bestOpponent = -1;
+        for (int h = 1; h < numHands; h++) {
+            bestOpponent = std::max(bestOpponent, HandEvaluator::evaluateScore(hands + 7 * h, 7));
         }
         
         // Comparer
-        if (heroHand > bestOpponentHand) {
+        if (heroScore > bestOpponent) {
             wins++;
-        } else if (heroHand == bestOpponentHand) {
+        } else if (heroScore == bestOpponent) {
             ties++;
         } else {
             losses++;
         }
     }
     
+    EquityResult result;
+    result.simulations = simulations;
     result.winRate = (wins * 100.0) / simulations;
     result.tieRate = (ties * 100.0) / simulations;
     result.loseRate = (losses * 100.0) / simulations;
     
+    if (Instrumentation::enabled()) {
+        Instrumentation::addQuery(simulations, static_cast<uint64_t>(simulations) * numHands);
+    }
+    
     return result;
 }
 
@@ -165,10 +298,13 @@ DecisionResult PokerSolver::analyzeDecision(
     int numOpponents,
     int simulations
 ) {
-    DecisionResult result;
-    
     // Calculer l'équité
     EquityResult equity = calculateEquity(holeCards, board, numOpponents, simulations);
+    return decide(equity, potSize, callAmount);
+}
+
+DecisionResult PokerSolver::decide(const EquityResult& equity, int potSize, int callAmount) const {
+    DecisionResult result;
     result.equity = equity.winRate + (equity.tieRate / 2.0); // Split les ties
     
     // Calculer les pot odds
@@ -200,60 +336,94 @@ DecisionResult PokerSolver::analyzeDecision(
     return result;
 }
 
-double PokerSolver::calculateEV(double equity, int potSize, int callAmount) const {
-    // EV = (Probabilité de gagner × Gain) - (Probabilité de perdre × Perte)
-    double winAmount = potSize;
-    double loseAmount = callAmount;
+DecisionResult PokerSolver::analyzeDecisionICM(
+    const std::vector<Card>& holeCards,
+    const std::vector<Card>& board,
+    int potSize,
+    int callAmount,
+    int numOpponents,
+    const std::vector<int>& stacks,
+    int heroSeat,
+    int villainSeat,
+    const std::vector<double>& payouts,
+    int simulations
+) {
+    // Sièges vérifiés avant la simulation
+    AllInOutcomes outcomes = allInOutcomes(stacks, potSize, callAmount, heroSeat, villainSeat);
     
-    return (equity * winAmount) - ((1.0 - equity) * loseAmount);
+    DecisionResult result;
+    result.prizeEquity = true;
+    
+    EquityResult equity = calculateEquity(holeCards, board, numOpponents, simulations);
+    double winChance = (equity.winRate + equity.tieRate / 2.0) / 100.0;
+    result.equity = winChance * 100.0;
+    
+    ICMCalculator icm(payouts);
+    // Un joueur éliminé dans le coup garde la place payée la plus basse encore libre
+    const std::vector<int> inHand = {heroSeat, villainSeat};
+    double evFold = icm.equitiesAfterHand(outcomes.afterFold, inHand)[heroSeat];
+    double evWin = icm.equitiesAfterHand(outcomes.afterWin, inHand)[heroSeat];
+    double evLose = icm.equitiesAfterHand(outcomes.afterLose, inHand)[heroSeat];
+    double evCall = winChance * evWin + (1.0 - winChance) * evLose;
+    
+    // Equity at which calling and folding are worth the same prize equity
+    result.potOdds = evWin > evLose ? (evFold - evLose) * 100.0 / (evWin - evLose) : 100.0;
+    result.expectedValue = evCall - evFold;
+    result.shouldCall = evCall > evFold;
+    
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << "Under ICM your equity (" << result.equity << "%) is "
+        << (result.shouldCall ? "higher" : "lower") << " than the required " << result.potOdds
+        << "% (chip pot odds: " << calculatePotOdds(potSize - outcomes.excess, outcomes.call) << "%). ";
+    oss << "Calling is worth " << evCall << " in prize equity versus " << evFold << " for folding.";
+    result.reasoning = oss.str();
+    
+    return result;
 }
 
-int PokerSolver::simulateHand(
-    const std::vector<Card>& heroCards,
-    std::vector<Card> currentBoard,
-    int numOpponents,
-    const std::vector<Card>& deadCards
+AllInOutcomes PokerSolver::allInOutcomes(
+    const std::vector<int>& stacks,
+    int potSize,
+    int callAmount,
+    int heroSeat,
+    int villainSeat
 ) {
-    // Créer un deck sans les cartes mortes
-    Deck deck;
-    deck.removeCards(deadCards);
-    
-    // Compléter le board
-    while (currentBoard.size() < 5) {
-        currentBoard.push_back(deck.draw());
+    int seats = static_cast<int>(stacks.size());
+    if (heroSeat < 0 || heroSeat >= seats || villainSeat < 0 || villainSeat >= seats || heroSeat == villainSeat) {
+        throw std::invalid_argument("Invalid hero or villain seat");
     }
     
-    // Évaluer la main du héros
-    std::vector<Card> heroFullHand = heroCards;
-    heroFullHand.insert(heroFullHand.end(), currentBoard.begin(), currentBoard.end());
-    HandValue heroHand = HandEvaluator::evaluate(heroFullHand);
+    AllInOutcomes outcomes;
+    outcomes.call = std::min(callAmount, stacks[heroSeat]);
+    // Partie de la mise que le héros ne peut pas suivre: rendue au vilain quelle que soit l'issue
+    outcomes.excess = callAmount - outcomes.call;
     
-    // Générer des mains aléatoires pour les adversaires
-    HandValue bestOpponentHand;
-    bool firstOpponent = true;
+    outcomes.afterFold.assign(stacks.begin(), stacks.end());
+    outcomes.afterFold[villainSeat] += potSize;
     
-    for (int i = 0; i < numOpponents; i++) {
-        std::vector<Card> opponentCards;
-        opponentCards.push_back(deck.draw());
-        opponentCards.push_back(deck.draw());
-        
-        std::vector<Card> opponentFullHand = opponentCards;
-        opponentFullHand.insert(opponentFullHand.end(), currentBoard.begin(), currentBoard.end());
-        
-        HandValue opponentHand = HandEvaluator::evaluate(opponentFullHand);
-        
-        if (firstOpponent || opponentHand > bestOpponentHand) {
-            bestOpponentHand = opponentHand;
-            firstOpponent = false;
-        }
-    }
+    outcomes.afterWin.assign(stacks.begin(), stacks.end());
+    outcomes.afterWin[heroSeat] += potSize - outcomes.excess;
+    outcomes.afterWin[villainSeat] += outcomes.excess;
     
-    // Comparer
-    if (heroHand > bestOpponentHand) {
-        return 1; // Victoire
-    } else if (heroHand == bestOpponentHand) {
-        return 0; // Égalité
-    } else {
-        return -1; // Défaite
-    }
+    outcomes.afterLose.assign(stacks.begin(), stacks.end());
+    outcomes.afterLose[heroSeat] -= outcomes.call;
+    outcomes.afterLose[villainSeat] += potSize + outcomes.call;
+    
+    return outcomes;
+}
+
+double PokerSolver::calculateEV(double equity, int potSize, int callAmount) const {
+    // EV = (Probabilité de gagner × Gain) - (Probabilité de perdre × Perte)
+    double winAmount = potSize;
+    double loseAmount = callAmount;
+    
+    return (equity * winAmount) - ((1.0 - equity) * loseAmount);
+}
+
+unsigned int PokerSolver::nextSeed() {
+    // Horloge comme Deck, plus un compteur: deux appels simultanés ne tirent pas les mêmes cartes
+    static std::atomic<unsigned int> counter(0);
+    auto now = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    return static_cast<unsigned int>(now) ^ (counter.fetch_add(1) * 0x9E3779B9u);
 }
@@ -1,145 +1,305 @@
 #include "../include/PotManager.h"
 #include "HandEvaluator.h"
 #include <algorithm>
+#include <random>
 #include <sstream>
+#include <stdexcept>
 
-PotManager::PotManager() : currentBet(0) {
-    pots.push_back(Pot()); // Pot principal
+PotManager::PotManager() : numPots(1), numSeats(0), currentBet(0) {
+    std::fill(seatPlayers, seatPlayers + MAX_SEATS, nullptr);
 }
 
 void PotManager::addToPot(Player* player, int amount) {
+    (void)player; // L'éligibilité est calculée par calculatePots
     pots[0].amount += amount;
-    if (!pots[0].eligiblePlayers.empty()) {
-        auto it = std::find(pots[0].eligiblePlayers.begin(), 
-                           pots[0].eligiblePlayers.end(), player);
-        if (it == pots[0].eligiblePlayers.end()) {
-            pots[0].eligiblePlayers.push_back(player);
+}
+
+void PotManager::calculatePots(std::vector<Player*>& players) {
+    if (players.size() > static_cast<size_t>(MAX_SEATS)) {
+        throw std::invalid_argument("At most 9 seats");
+    }
+
+    int contributions[MAX_SEATS];
+    uint16_t liveSeats = 0;
+    for (size_t s = 0; s < players.size(); s++) {
+        seatPlayers[s] = players[s];
+        contributions[s] = players[s]->getTotalBetInHand();
+        if (players[s]->isActive()) {
+            liveSeats |= 1u << s;
         }
     }
+
+    calculatePots(contributions, liveSeats, static_cast<int>(players.size()));
 }
 
-void PotManager::calculatePots(std::vector<Player*>& players) {
-    pots.clear();
-    
-    // Créer une liste de (joueur, montant misé)
-    std::vector<std::pair<Player*, int>> bets;
-    for (auto* player : players) {
-        if (player->getTotalBetInHand() > 0 && player->isActive()) {
-            bets.push_back({player, player->getTotalBetInHand()});
-        }
-    }
-    
-    if (bets.empty()) {
-        pots.push_back(Pot());
-        return;
-    }
-    
-    // Trier par montant misé
-    std::sort(bets.begin(), bets.end(), 
-              [](const auto& a, const auto& b) { return a.second < b.second; });
-    
+void PotManager::calculatePots(const int* contributions, uint16_t liveSeats, int seats) {
+    if (seats < 0 || seats > MAX_SEATS) {
+        throw std::invalid_argument("At most 9 seats");
+    }
+    numSeats = seats;
+    numPots = 0;
+
+    // Niveaux de pot: mises distinctes des joueurs encore en main, triées
+    int levels[MAX_SEATS];
+    int numLevels = 0;
+    for (int s = 0; s < seats; s++) {
+        int level = contributions[s];
+        if (!(liveSeats & (1u << s)) || level <= 0) continue;
+
+        int pos = numLevels;
+        while (pos > 0 && levels[pos - 1] > level) pos--;
+        if (pos > 0 && levels[pos - 1] == level) continue;
+        for (int i = numLevels; i > pos; i--) levels[i] = levels[i - 1];
+        levels[pos] = level;
+        numLevels++;
+    }
+
     int previousLevel = 0;
-    
-    for (size_t i = 0; i < bets.size(); i++) {
-        int currentLevel = bets[i].second;
-        
-        if (currentLevel > previousLevel) {
-            Pot pot;
-            int betPerPlayer = currentLevel - previousLevel;
-            
-            // Tous les joueurs à partir de i contribuent à ce pot
-            for (size_t j = i; j < bets.size(); j++) {
-                pot.amount += betPerPlayer;
-                pot.eligiblePlayers.push_back(bets[j].first);
+    for (int l = 0; l < numLevels; l++) {
+        // Le dernier pot reçoit aussi l'argent mort au-dessus du dernier niveau
+        const bool lastLevel = l == numLevels - 1;
+        Pot& pot = pots[numPots++];
+        pot.amount = 0;
+        pot.eligibleSeats = 0;
+
+        for (int s = 0; s < seats; s++) {
+            int contributed = contributions[s];
+            if (contributed > previousLevel) {
+                pot.amount += (lastLevel ? contributed : std::min(contributed, levels[l])) - previousLevel;
+            }
+            if ((liveSeats & (1u << s)) && contributed >= levels[l]) {
+                pot.eligibleSeats |= 1u << s;
             }
-            
-            pots.push_back(pot);
-            previousLevel = currentLevel;
         }
+        previousLevel = levels[l];
     }
-    
-    if (pots.empty()) {
-        pots.push_back(Pot());
+
+    if (numPots == 0) {
+        pots[0] = Pot();
+        for (int s = 0; s < seats; s++) {
+            pots[0].amount += contributions[s];
+        }
+        numPots = 1;
     }
 }
 
 void PotManager::distributePots(const std::vector<std::pair<Player*, HandValue>>& playerHands) {
-    for (auto& pot : pots) {
-        if (pot.amount == 0) continue;
-        
-        // Trouver le(s) gagnant(s) parmi les joueurs éligibles
-        std::vector<std::pair<Player*, HandValue>> eligibleHands;
-        
-        for (const auto& ph : playerHands) {
-            auto it = std::find(pot.eligiblePlayers.begin(), 
-                               pot.eligiblePlayers.end(), ph.first);
-            if (it != pot.eligiblePlayers.end()) {
-                eligibleHands.push_back(ph);
+    if (playerHands.empty()) return;
+
+    int scores[MAX_SEATS];
+    std::fill(scores, scores + MAX_SEATS, -1);
+    int firstSeat = -1;
+
+    for (const auto& ph : playerHands) {
+        for (int s = 0; s < numSeats; s++) {
+            if (seatPlayers[s] == ph.first) {
+                scores[s] = ph.second.score;
+                if (firstSeat < 0) firstSeat = s;
+                break;
             }
         }
-        
-        if (eligibleHands.empty()) continue;
-        
-        // Trouver la meilleure main
-        HandValue bestHand = eligibleHands[0].second;
-        for (const auto& eh : eligibleHands) {
-            if (eh.second > bestHand) {
-                bestHand = eh.second;
+    }
+    if (firstSeat < 0) return;
+
+    // Les joueurs sans main montrée ne peuvent rien gagner
+    int winnings[MAX_SEATS];
+    PotManager showdownPots(*this);
+    for (int p = 0; p < numPots; p++) {
+        for (int s = 0; s < numSeats; s++) {
+            if (scores[s] < 0) showdownPots.pots[p].eligibleSeats &= static_cast<uint16_t>(~(1u << s));
+        }
+    }
+    showdownPots.distributePots(scores, firstSeat, winnings);
+
+    for (int s = 0; s < numSeats; s++) {
+        if (winnings[s] > 0) {
+            seatPlayers[s]->addChips(winnings[s]);
+        }
+    }
+}
+
+void PotManager::distributePots(const int* scores, int firstSeat, int* winnings) const {
+    std::fill(winnings, winnings + numSeats, 0);
+
+    // Classer une seule fois les mains en lice (meilleure d'abord)
+    uint16_t contenders = 0;
+    for (int p = 0; p < numPots; p++) {
+        contenders |= pots[p].eligibleSeats;
+    }
+    int ranked[MAX_SEATS];
+    int numRanked = 0;
+    for (int s = 0; s < numSeats; s++) {
+        if (!(contenders & (1u << s))) continue;
+        int pos = numRanked++;
+        while (pos > 0 && scores[ranked[pos - 1]] < scores[s]) {
+            ranked[pos] = ranked[pos - 1];
+            pos--;
+        }
+        ranked[pos] = s;
+    }
+
+    for (int p = 0; p < numPots; p++) {
+        const Pot& pot = pots[p];
+        if (pot.amount == 0 || pot.eligibleSeats == 0) continue;
+
+        // Gagnants: les premières mains éligibles du classement, à égalité
+        uint16_t winners = 0;
+        int count = 0;
+        int best = 0;
+        for (int i = 0; i < numRanked; i++) {
+            int seat = ranked[i];
+            if (!(pot.eligibleSeats & (1u << seat))) continue;
+            if (count == 0) {
+                best = scores[seat];
+            } else if (scores[seat] < best) {
+                break;
             }
+            winners |= 1u << seat;
+            count++;
         }
-        
-        // Compter les gagnants (peut y avoir des splits)
-        std::vector<Player*> winners;
-        for (const auto& eh : eligibleHands) {
-            if (eh.second == bestHand) {
-                winners.push_back(eh.first);
+
+        int share = pot.amount / count;
+        int remainder = pot.amount % count;
+        for (int i = 0; i < numSeats; i++) {
+            int seat = (firstSeat + i) % numSeats;
+            if (!(winners & (1u << seat))) continue;
+            winnings[seat] += share;
+            if (remainder > 0) {
+                winnings[seat]++; // Distribuer le reste aux premiers gagnants
+                remainder--;
             }
         }
-        
-        // Distribuer le pot
-        int amountPerWinner = pot.amount / winners.size();
-        int remainder = pot.amount % winners.size();
-        
-        for (size_t i = 0; i < winners.size(); i++) {
-            int winAmount = amountPerWinner;
-            if (i < static_cast<size_t>(remainder)) {
-                winAmount++; // Distribuer le reste aux premiers gagnants
+    }
+}
+
+std::vector<double> PotManager::allInExpectedWinnings(const std::vector<std::vector<Card>>& holeCards,
+                                                      const std::vector<Card>& board,
+                                                      const std::vector<int>& contributions,
+                                                      int maxRunouts, int firstSeat, unsigned int seed) {
+    const int seats = static_cast<int>(holeCards.size());
+    if (static_cast<int>(contributions.size()) != seats || seats > MAX_SEATS) {
+        throw std::invalid_argument("One contribution per player required (at most 9 players)");
+    }
+    if (board.size() > 5) {
+        throw std::invalid_argument("Board has more than 5 cards");
+    }
+    if (maxRunouts < 1) {
+        throw std::invalid_argument("At least one runout required");
+    }
+
+    uint16_t liveSeats = 0;
+    uint64_t used = 0;
+    uint8_t hands[MAX_SEATS][7];
+    for (int s = 0; s < seats; s++) {
+        if (holeCards[s].empty()) continue;
+        if (holeCards[s].size() != 2) {
+            throw std::invalid_argument("Live players need exactly 2 hole cards");
+        }
+        liveSeats |= 1u << s;
+        hands[s][0] = static_cast<uint8_t>(holeCards[s][0].toIndex());
+        hands[s][1] = static_cast<uint8_t>(holeCards[s][1].toIndex());
+        for (size_t i = 0; i < board.size(); i++) {
+            hands[s][2 + i] = static_cast<uint8_t>(board[i].toIndex());
+        }
+        used |= (1ULL << hands[s][0]) | (1ULL << hands[s][1]);
+    }
+    for (const auto& card : board) used |= 1ULL << card.toIndex();
+
+    PotManager potManager;
+    potManager.calculatePots(contributions.data(), liveSeats, seats);
+
+    uint8_t deck[52];
+    int remaining = 0;
+    for (int c = 0; c < 52; c++) {
+        if (!(used & (1ULL << c))) deck[remaining++] = static_cast<uint8_t>(c);
+    }
+    const int missing = 5 - static_cast<int>(board.size());
+
+    std::vector<double> expected(seats, 0.0);
+    int scores[MAX_SEATS] = {0};
+    int winnings[MAX_SEATS];
+    long long runouts = 0;
+
+    auto scoreRunout = [&](const uint8_t* runout) {
+        for (int s = 0; s < seats; s++) {
+            if (!(liveSeats & (1u << s))) continue;
+            for (int i = 0; i < missing; i++) hands[s][7 - missing + i] = runout[i];
+            scores[s] = HandEvaluator::evaluateScore(hands[s], 7);
+        }
+        potManager.distributePots(scores, firstSeat, winnings);
+        for (int s = 0; s < seats; s++) {
+            expected[s] += winnings[s];
+        }
+        runouts++;
+    };
+
+    // Nombre de tirages possibles
+    double combinations = 1.0;
+    for (int i = 0; i < missing; i++) {
+        combinations = combinations * (remaining - i) / (i + 1);
+    }
+
+    uint8_t runout[5];
+    if (combinations <= maxRunouts) {
+        int idx[5];
+        for (int i = 0; i < missing; i++) idx[i] = i;
+        while (true) {
+            for (int i = 0; i < missing; i++) runout[i] = deck[idx[i]];
+            scoreRunout(runout);
+
+            int i = missing - 1;
+            while (i >= 0 && idx[i] == remaining - missing + i) i--;
+            if (i < 0) break;
+            idx[i]++;
+            for (int j = i + 1; j < missing; j++) idx[j] = idx[j - 1] + 1;
+        }
+    } else {
+        std::mt19937 rng(seed);
+        for (int r = 0; r < maxRunouts; r++) {
+            for (int i = 0; i < missing; i++) {
+                std::uniform_int_distribution<int> pick(i, remaining - 1);
+                std::swap(deck[i], deck[pick(rng)]);
+                runout[i] = deck[i];
             }
-            winners[i]->addChips(winAmount);
+            scoreRunout(runout);
         }
     }
+
+    for (auto& value : expected) {
+        value /= runouts;
+    }
+    return expected;
 }
 
 int PotManager::getTotalPot() const {
     int total = 0;
-    for (const auto& pot : pots) {
-        total += pot.amount;
+    for (int p = 0; p < numPots; p++) {
+        total += pots[p].amount;
     }
     return total;
 }
 
 int PotManager::getMainPot() const {
-    if (pots.empty()) return 0;
     return pots[0].amount;
 }
 
 void PotManager::reset() {
-    pots.clear();
-    pots.push_back(Pot());
+    pots[0] = Pot();
+    numPots = 1;
     currentBet = 0;
 }
 
 std::string PotManager::toString() const {
     std::ostringstream oss;
     oss << "Total Pot: " << getTotalPot() << " chips";
-    
-    if (pots.size() > 1) {
+
+    if (numPots > 1) {
         oss << " (Main Pot: " << pots[0].amount;
-        for (size_t i = 1; i < pots.size(); i++) {
+        for (int i = 1; i < numPots; i++) {
             oss << ", Side Pot " << i << ": " << pots[i].amount;
         }
         oss << ")";
     }
-    
+
     return oss.str();
 }
@@ -0,0 +1,472 @@
+#include "../include/PushFoldSolver.h"
+#include "../include/HandEvaluator.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+const int N = HandClass::COUNT;
+const char EQUITY_MAGIC[4] = {'P', 'S', 'E', 'Q'};
+const uint32_t EQUITY_VERSION = 1;
+
+struct ComboIdx {
+    uint8_t c1;
+    uint8_t c2;
+};
+
+std::vector<ComboIdx> classCombos(int classIndex) {
+    std::vector<ComboIdx> result;
+    for (const auto& combo : HandClass::fromIndex(classIndex).combos()) {
+        result.push_back({static_cast<uint8_t>(combo.first.toIndex()),
+                          static_cast<uint8_t>(combo.second.toIndex())});
+    }
+    return result;
+}
+
+bool overlaps(const ComboIdx& a, const ComboIdx& b) {
+    return a.c1 == b.c1 || a.c1 == b.c2 || a.c2 == b.c1 || a.c2 == b.c2;
+}
+
+// Monte Carlo all-in equity of class a against class b
+double matchupEquity(const std::vector<ComboIdx>& combosA, const std::vector<ComboIdx>& combosB,
+                     int trials, std::mt19937& rng) {
+    std::uniform_int_distribution<size_t> pickA(0, combosA.size() - 1);
+    std::uniform_int_distribution<size_t> pickB(0, combosB.size() - 1);
+
+    double points = 0.0;
+    uint8_t deck[52];
+    uint8_t handA[7];
+    uint8_t handB[7];
+
+    for (int t = 0; t < trials; t++) {
+        ComboIdx a = combosA[pickA(rng)];
+        ComboIdx b = combosB[pickB(rng)];
+        while (overlaps(a, b)) {
+            a = combosA[pickA(rng)];
+            b = combosB[pickB(rng)];
+        }
+
+        int remaining = 0;
+        for (int c = 0; c < 52; c++) {
+            if (c != a.c1 && c != a.c2 && c != b.c1 && c != b.c2) {
+                deck[remaining++] = static_cast<uint8_t>(c);
+            }
+        }
+
+        // Partial Fisher-Yates: the first five slots become the board
+        for (int i = 0; i < 5; i++) {
+            int j = i + static_cast<int>(rng() % static_cast<unsigned>(remaining - i));
+            std::swap(deck[i], deck[j]);
+            handA[2 + i] = handB[2 + i] = deck[i];
+        }
+        handA[0] = a.c1; handA[1] = a.c2;
+        handB[0] = b.c1; handB[1] = b.c2;
+
+        int scoreA = HandEvaluator::evaluateScore(handA, 7);
+        int scoreB = HandEvaluator::evaluateScore(handB, 7);
+        if (scoreA > scoreB) points += 1.0;
+        else if (scoreA == scoreB) points += 0.5;
+    }
+
+    return points / trials;
+}
+
+double classFrequency(int classIndex) {
+    return HandClass::fromIndex(classIndex).comboCount() / 1326.0;
+}
+
+} // namespace
+
+// ==================== PushFoldResult ====================
+
+double PushFoldResult::rangePercent(const ClassStrategy& strategy) {
+    double total = 0.0;
+    for (int c = 0; c < N; c++) {
+        total += strategy[c] * classFrequency(c);
+    }
+    return total * 100.0;
+}
+
+std::string PushFoldResult::rangeString(const ClassStrategy& strategy) {
+    std::string result;
+    for (int c = 0; c < N; c++) {
+        if (strategy[c] >= 0.5) {
+            if (!result.empty()) result += ", ";
+            result += HandClass::fromIndex(c).toString();
+        }
+    }
+    return result.empty() ? "(none)" : result;
+}
+
+std::string PushFoldResult::chart(const ClassStrategy& strategy) {
+    std::string result;
+    for (int row = 0; row < 13; row++) {
+        for (int col = 0; col < 13; col++) {
+            result += strategy[row * 13 + col] >= 0.5 ? '#' : '.';
+            result += ' ';
+        }
+        result += '\n';
+    }
+    return result;
+}
+
+std::string PushFoldResult::toString() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "=== Push/Fold (" << numPlayers << " players, "
+        << *std::min_element(stacks.begin(), stacks.end()) << " bb) ===" << std::endl;
+
+    for (int i = 0; i < numPlayers - 1; i++) {
+        std::string opener = PushFoldSolver::positionName(i, numPlayers);
+        oss << opener << " jam (" << rangePercent(jam[i]) << "%): " << rangeString(jam[i]) << std::endl;
+        for (int j = i + 1; j < numPlayers; j++) {
+            oss << "  " << PushFoldSolver::positionName(j, numPlayers) << " call vs " << opener
+                << " (" << rangePercent(call[i][j]) << "%): " << rangeString(call[i][j]) << std::endl;
+        }
+    }
+
+    oss << std::setprecision(4);
+    oss << "Exploitability: " << exploitability << " bb after " << iterations << " iterations" << std::endl;
+    return oss.str();
+}
+
+// ==================== PushFoldSolver ====================
+
+PushFoldSolver::PushFoldSolver(int trials, const std::string& cachePath)
+    : trialsPerMatchup(trials), equityCachePath(cachePath) {
+    if (trialsPerMatchup <= 0) {
+        throw std::invalid_argument("Trials per matchup must be positive");
+    }
+}
+
+std::string PushFoldSolver::positionName(int position, int numPlayers) {
+    static const char* FROM_BB[] = {"BB", "SB", "BTN", "CO", "HJ", "LJ"};
+    int fromBB = numPlayers - 1 - position;
+
+    if (fromBB <= 2) return FROM_BB[fromBB];
+    if (position == 0) return "UTG";
+    if (fromBB < 6) return FROM_BB[fromBB];
+    return "UTG+" + std::to_string(position);
+}
+
+double PushFoldSolver::equity(const HandClass& hero, const HandClass& villain) {
+    ensureTables();
+    return equities[hero.index() * N + villain.index()];
+}
+
+void PushFoldSolver::ensureTables() {
+    if (!equities.empty()) {
+        return;
+    }
+
+    // Blocker-adjusted combo weights (exact, cheap)
+    std::vector<std::vector<ComboIdx>> combos(N);
+    for (int c = 0; c < N; c++) {
+        combos[c] = classCombos(c);
+    }
+
+    weights.assign(N * N, 0.0f);
+    for (int h = 0; h < N; h++) {
+        for (int v = 0; v < N; v++) {
+            int compatible = 0;
+            for (const auto& hc : combos[h]) {
+                for (const auto& vc : combos[v]) {
+                    if (!overlaps(hc, vc)) compatible++;
+                }
+            }
+            weights[h * N + v] = static_cast<float>(compatible) / combos[h].size();
+        }
+    }
+
+    if (!loadEquityTable()) {
+        computeEquityTable();
+        saveEquityTable();
+    }
+
+    weightedEquities.resize(N * N);
+    for (int i = 0; i < N * N; i++) {
+        weightedEquities[i] = static_cast<double>(weights[i]) * equities[i];
+    }
+}
+
+void PushFoldSolver::computeEquityTable() {
+    equities.assign(N * N, 0.5f);
+
+    std::vector<std::vector<ComboIdx>> combos(N);
+    for (int c = 0; c < N; c++) {
+        combos[c] = classCombos(c);
+    }
+
+    std::atomic<int> nextRow(0);
+    auto worker = [&]() {
+        for (int a = nextRow++; a < N; a = nextRow++) {
+            TraceSpan row("equity table row", "chunk", a);
+            for (int b = a + 1; b < N; b++) {
+                std::mt19937 rng(static_cast<unsigned>(a * N + b));
+                double eq = matchupEquity(combos[a], combos[b], trialsPerMatchup, rng);
+                equities[a * N + b] = static_cast<float>(eq);
+                equities[b * N + a] = static_cast<float>(1.0 - eq);
+            }
+        }
+    };
+
+    int numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < numThreads; t++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+bool PushFoldSolver::loadEquityTable() {
+    if (equityCachePath.empty()) {
+        return false;
+    }
+
+    std::ifstream in(equityCachePath, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    int32_t trials = 0;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in.read(reinterpret_cast<char*>(&trials), sizeof(trials));
+    if (!in || std::memcmp(magic, EQUITY_MAGIC, sizeof(magic)) != 0 || version != EQUITY_VERSION) {
+        return false;
+    }
+    // Table moins précise que demandé: recalculée (une table plus précise est gardée)
+    if (trials < trialsPerMatchup) {
+        return false;
+    }
+
+    std::vector<float> table(N * N);
+    in.read(reinterpret_cast<char*>(table.data()), table.size() * sizeof(float));
+    if (!in) {
+        return false;
+    }
+
+    equities.swap(table);
+    return true;
+}
+
+void PushFoldSolver::saveEquityTable() const {
+    if (equityCachePath.empty()) {
+        return;
+    }
+
+    TraceSpan span("equity table write", "checkpoint");
+    std::ofstream out(equityCachePath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return; // Caching is best effort
+    }
+
+    int32_t trials = trialsPerMatchup;
+    out.write(EQUITY_MAGIC, sizeof(EQUITY_MAGIC));
+    out.write(reinterpret_cast<const char*>(&EQUITY_VERSION), sizeof(EQUITY_VERSION));
+    out.write(reinterpret_cast<const char*>(&trials), sizeof(trials));
+    out.write(reinterpret_cast<const char*>(equities.data()), equities.size() * sizeof(float));
+}
+
+PushFoldResult PushFoldSolver::solve(const PushFoldConfig& config) {
+    const int n = config.numPlayers;
+    if (n < 2 || n > 9) {
+        throw std::invalid_argument("Number of players must be between 2 and 9");
+    }
+
+    std::vector<double> stacks = config.stacks.empty()
+        ? std::vector<double>(n, config.stack)
+        : config.stacks;
+    if (static_cast<int>(stacks.size()) != n) {
+        throw std::invalid_argument("One stack per player required");
+    }
+
+    TraceSpan span("push/fold solve", "job", n);
+    ensureTables();
+
+    // Forced bets: antes for everybody, blinds for the last two positions
+    std::vector<double> ante(n), blind(n, 0.0);
+    for (int k = 0; k < n; k++) {
+        if (stacks[k] <= 0.0) {
+            throw std::invalid_argument("Stacks must be positive");
+        }
+        ante[k] = std::min(config.ante, stacks[k]);
+    }
+    blind[n - 2] = std::min(config.smallBlind, stacks[n - 2] - ante[n - 2]);
+    blind[n - 1] = std::min(config.bigBlind, stacks[n - 1] - ante[n - 1]);
+
+    double deadTotal = 0.0;
+    for (int k = 0; k < n; k++) {
+        deadTotal += ante[k] + blind[k];
+    }
+
+    // Showdown amounts per (opener, caller)
+    std::vector<double> effective(n * n, 0.0), pot(n * n, 0.0);
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            double e = std::min(stacks[i] - ante[i], stacks[j] - ante[j]);
+            effective[i * n + j] = e;
+            pot[i * n + j] = 2.0 * e + deadTotal - blind[i] - blind[j];
+        }
+    }
+
+    std::vector<double> freq(N), totalWeight(N, 0.0);
+    for (int c = 0; c < N; c++) {
+        freq[c] = classFrequency(c);
+        for (int v = 0; v < N; v++) totalWeight[c] += weights[c * N + v];
+    }
+
+    PushFoldResult result;
+    result.numPlayers = n;
+    result.stacks = stacks;
+    result.jam.assign(n, ClassStrategy());
+    result.call.assign(n, std::vector<ClassStrategy>(n, ClassStrategy()));
+    for (int i = 0; i < n; i++) {
+        result.jam[i].fill(0.5);
+        for (int j = 0; j < n; j++) result.call[i][j].fill(0.5);
+    }
+    result.jam[n - 1].fill(0.0); // Folded to the BB: the hand is over
+
+    std::vector<ClassStrategy> brJam(n);
+    std::vector<std::vector<ClassStrategy>> brCall(n, std::vector<ClassStrategy>(n));
+    std::vector<double> evJam(N), jamWeight(N), jamEquity(N);
+
+    result.iterations = 0;
+    result.exploitability = 0.0;
+
+    for (int iter = 1; iter <= config.maxIterations; iter++) {
+        TraceSpan iteration("fictitious play iteration", "iteration", iter);
+        double exploitability = 0.0;
+        double reachOpen = 1.0; // Everybody before the opener folded
+
+        for (int i = 0; i < n - 1; i++) {
+            // Opener: EV of jamming each class against the current call ranges
+            std::fill(evJam.begin(), evJam.end(), 0.0);
+            std::vector<double> reachBefore(N, 1.0);
+
+            for (int j = i + 1; j < n; j++) {
+                const ClassStrategy& callRange = result.call[i][j];
+                double e = effective[i * n + j];
+                double p = pot[i * n + j];
+
+                for (int h = 0; h < N; h++) {
+                    const float* w = &weights[h * N];
+                    const double* weq = &weightedEquities[h * N];
+                    double calledWeight = 0.0, equitySum = 0.0;
+                    for (int v = 0; v < N; v++) {
+                        calledWeight += w[v] * callRange[v];
+                        equitySum += weq[v] * callRange[v];
+                    }
+
+                    double pCall = calledWeight / totalWeight[h];
+                    if (calledWeight > 0.0) {
+                        double eqCalled = equitySum / calledWeight;
+                        evJam[h] += reachBefore[h] * pCall * (eqCalled * p - e - ante[i]);
+                    }
+                    reachBefore[h] *= 1.0 - pCall;
+                }
+            }
+
+            double steal = deadTotal - ante[i] - blind[i];
+            double evFold = -(ante[i] + blind[i]);
+            double gain = 0.0;
+            for (int h = 0; h < N; h++) {
+                evJam[h] += reachBefore[h] * steal;
+                brJam[i][h] = evJam[h] > evFold ? 1.0 : 0.0;
+
+                double best = std::max(evJam[h], evFold);
+                double mixed = result.jam[i][h] * evJam[h] + (1.0 - result.jam[i][h]) * evFold;
+                gain += freq[h] * (best - mixed);
+            }
+            exploitability += reachOpen * gain;
+
+            // Callers: equity of each class against the opener's jam range,
+            // shared by every caller since overcalls are not modeled
+            const ClassStrategy& jamRange = result.jam[i];
+            for (int c = 0; c < N; c++) {
+                const float* w = &weights[c * N];
+                const double* weq = &weightedEquities[c * N];
+                double weight = 0.0, equitySum = 0.0;
+                for (int h = 0; h < N; h++) {
+                    weight += w[h] * jamRange[h];
+                    equitySum += weq[h] * jamRange[h];
+                }
+                jamWeight[c] = weight;
+                jamEquity[c] = weight > 0.0 ? equitySum / weight : 0.0;
+            }
+
+            double jamRate = PushFoldResult::rangePercent(jamRange) / 100.0;
+            double reachCaller = reachOpen * jamRate;
+
+            for (int j = i + 1; j < n; j++) {
+                double e = effective[i * n + j];
+                double p = pot[i * n + j];
+                double callFold = -(ante[j] + blind[j]);
+                double callGain = 0.0;
+
+                for (int c = 0; c < N; c++) {
+                    double evCall = jamWeight[c] > 0.0 ? jamEquity[c] * p - e - ante[j] : callFold;
+                    brCall[i][j][c] = evCall > callFold ? 1.0 : 0.0;
+
+                    double best = std::max(evCall, callFold);
+                    double mixed = result.call[i][j][c] * evCall + (1.0 - result.call[i][j][c]) * callFold;
+                    callGain += freq[c] * (best - mixed);
+                }
+
+                exploitability += reachCaller * callGain;
+                reachCaller *= 1.0 - PushFoldResult::rangePercent(result.call[i][j]) / 100.0;
+            }
+
+            reachOpen *= 1.0 - jamRate;
+        }
+
+        result.iterations = iter;
+        result.exploitability = exploitability;
+        if (exploitability < config.tolerance) {
+            break;
+        }
+
+        // Fictitious play: average in the best responses
+        double step = 1.0 / (iter + 1);
+        for (int i = 0; i < n - 1; i++) {
+            for (int c = 0; c < N; c++) {
+                result.jam[i][c] += step * (brJam[i][c] - result.jam[i][c]);
+            }
+            for (int j = i + 1; j < n; j++) {
+                for (int c = 0; c < N; c++) {
+                    result.call[i][j][c] += step * (brCall[i][j][c] - result.call[i][j][c]);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+std::vector<PushFoldResult> PushFoldSolver::solveChart(const PushFoldConfig& config,
+                                                       double minStack, double maxStack, double step) {
+    if (step <= 0.0 || minStack <= 0.0 || maxStack < minStack) {
+        throw std::invalid_argument("Invalid stack depth range");
+    }
+
+    std::vector<PushFoldResult> results;
+    for (double stack = minStack; stack <= maxStack + 1e-9; stack += step) {
+        PushFoldConfig spot = config;
+        spot.stack = stack;
+        spot.stacks.clear();
+        results.push_back(solve(spot));
+    }
+    return results;
+}
@@ -0,0 +1,374 @@
+#include "../include/RangeHeatmap.h"
+#include "HandEvaluator.h"
+#include "../include/SolverStats.h"
+#include "../include/Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    const char RANK_LABELS[] = "AKQJT98765432";
+}
+
+std::string HeatmapGrid::toString() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "   ";
+    for (int col = 0; col < 13; col++) {
+        oss << std::setw(6) << RANK_LABELS[col];
+    }
+    oss << "\n";
+    for (int row = 0; row < 13; row++) {
+        oss << " " << RANK_LABELS[row] << " ";
+        for (int col = 0; col < 13; col++) {
+            const HeatmapCell& cell = cells[row * 13 + col];
+            if (cell.possible && cell.samples > 0) {
+                oss << std::setw(6) << cell.equity * 100.0;
+            } else {
+                oss << std::setw(6) << "--";
+            }
+        }
+        oss << "\n";
+    }
+    oss << trials << " runouts, " << convergedCells << "/" << possibleCells << " cells converged\n";
+    return oss.str();
+}
+
+RangeHeatmap::RangeHeatmap(size_t cacheEntries)
+    : maxCacheEntries(std::max<size_t>(1, cacheEntries)), generation(0) {
+}
+
+uint64_t RangeHeatmap::supersede() {
+    return ++generation;
+}
+
+std::string RangeHeatmap::canonicalKey(const std::vector<Card>& board, int numOpponents,
+                                       std::vector<uint8_t>& canonical) {
+    // Plus petit tableau trié sur les 24 permutations de couleurs
+    int suits[4] = {0, 1, 2, 3};
+    std::vector<uint8_t> candidate(board.size());
+    canonical.clear();
+    do {
+        for (size_t i = 0; i < board.size(); i++) {
+            const int index = board[i].toIndex();
+            candidate[i] = static_cast<uint8_t>(suits[index / 13] * 13 + index % 13);
+        }
+        std::sort(candidate.begin(), candidate.end());
+        if (canonical.empty() || candidate < canonical) {
+            canonical = candidate;
+        }
+    } while (std::next_permutation(suits, suits + 4));
+
+    std::string key(canonical.begin(), canonical.end());
+    key.push_back(static_cast<char>(64 + numOpponents));
+    return key;
+}
+
+void RangeHeatmap::fillGrid(const Entry& entry, const HeatmapConfig& config, HeatmapGrid& grid) {
+    grid.trials = entry.trials;
+    grid.possibleCells = 0;
+    grid.convergedCells = 0;
+    for (int c = 0; c < HandClass::COUNT; c++) {
+        const Sums& sums = entry.sums[c];
+        HeatmapCell& cell = grid.cells[c];
+        cell.possible = entry.possible[c];
+        cell.samples = sums.samples;
+        cell.equity = sums.weight > 0.0 ? sums.weighted / sums.weight : 0.0;
+
+        // Erreur type de la moyenne pondérée (estimateur par ratio)
+        const double variance = sums.weight > 0.0
+            ? std::max(0.0, sums.weightedSquares / sums.weight - cell.equity * cell.equity)
+            : 0.25;
+        cell.error = sums.weight > 0.0 ? std::sqrt(variance * sums.squaredWeights) / sums.weight : 1.0;
+        cell.converged = cell.possible && sums.samples >= config.minSamples && cell.error <= config.targetError;
+
+        grid.possibleCells += cell.possible ? 1 : 0;
+        grid.convergedCells += cell.converged ? 1 : 0;
+    }
+    grid.final = grid.convergedCells == grid.possibleCells || entry.trials >= config.maxTrials;
+}
+
+bool RangeHeatmap::cached(const HeatmapConfig& config, HeatmapGrid& grid) const {
+    std::vector<uint8_t> canonical;
+    const std::string key = canonicalKey(config.board, config.numOpponents, canonical);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(key);
+    if (Instrumentation::enabled()) {
+        Instrumentation::addCacheLookup(it != cache.end() && it->second->trials > 0);
+    }
+    if (it == cache.end() || it->second->trials == 0) return false;
+    fillGrid(*it->second, config, grid);
+    grid.fromCache = true;
+    grid.generation = generation.load();
+    return true;
+}
+
+bool RangeHeatmap::compute(const HeatmapConfig& config, uint64_t requestGeneration,
+                           const std::function<void(const HeatmapGrid&)>& onUpdate) {
+    const int boardSize = static_cast<int>(config.board.size());
+    if (boardSize > 5) {
+        throw std::invalid_argument("Maximum 5 cards on the board");
+    }
+    if (config.numOpponents < 1 || 2 + 5 + 2 * config.numOpponents > 52) {
+        throw std::invalid_argument("Invalid number of opponents");
+    }
+    for (int i = 0; i < boardSize; i++) {
+        for (int j = i + 1; j < boardSize; j++) {
+            if (config.board[i] == config.board[j]) {
+                throw std::invalid_argument("Duplicate board card");
+            }
+        }
+    }
+
+    TraceSpan span("heatmap.compute", "job");
+    const bool instrumented = Instrumentation::enabled();
+    const uint64_t setupStart = instrumented ? Instrumentation::ticks() : 0;
+    std::vector<uint8_t> board;
+    const std::string key = canonicalKey(config.board, config.numOpponents, board);
+    bool dead[52] = {false};
+    for (uint8_t card : board) {
+        dead[card] = true;
+    }
+
+    // Combos de chaque classe encore possibles avec le tableau connu
+    uint8_t combos[HandClass::COUNT][12][2];
+    int comboCounts[HandClass::COUNT];
+    for (int c = 0; c < HandClass::COUNT; c++) {
+        comboCounts[c] = 0;
+        for (const auto& combo : HandClass::fromIndex(c).combos()) {
+            const int a = combo.first.toIndex();
+            const int b = combo.second.toIndex();
+            if (dead[a] || dead[b]) continue;
+            combos[c][comboCounts[c]][0] = static_cast<uint8_t>(a);
+            combos[c][comboCounts[c]][1] = static_cast<uint8_t>(b);
+            comboCounts[c]++;
+        }
+    }
+
+    std::shared_ptr<Entry> entry;
+    HeatmapGrid start;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = cache.find(key);
+        if (instrumented) {
+            Instrumentation::addQuery(0, 0);
+            Instrumentation::addCacheLookup(it != cache.end());
+        }
+        if (it == cache.end()) {
+            if (cache.size() >= maxCacheEntries) {
+                cache.clear();
+            }
+            entry = std::make_shared<Entry>();
+            entry->board = board;
+            entry->numOpponents = config.numOpponents;
+            for (int c = 0; c < HandClass::COUNT; c++) {
+                entry->possible[c] = comboCounts[c] > 0;
+            }
+            cache.emplace(key, entry);
+        } else {
+            entry = it->second;
+        }
+        fillGrid(*entry, config, start);
+    }
+    if (instrumented) {
+        Instrumentation::addPhase(SolverPhase::SETUP, Instrumentation::ticks() - setupStart);
+    }
+    start.generation = requestGeneration;
+    start.fromCache = true;
+    if (start.trials > 0 && onUpdate) {
+        onUpdate(start);
+    }
+    if (start.final) {
+        return true;
+    }
+
+    int numThreads = config.threads > 0
+        ? config.threads
+        : std::max(1u, std::thread::hardware_concurrency());
+    const int roundTrials = std::max(1, config.roundTrials);
+    const int missingBoard = 5 - boardSize;
+    const int drawn = missingBoard + 2 * config.numOpponents;
+    const unsigned int seedBase = static_cast<unsigned int>(
+        std::chrono::high_resolution_clock::now().time_since_epoch().count());
+
+    std::atomic<bool> done(false);
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+
+    auto worker = [&](int t) {
+        const uint64_t workerStart = instrumented ? Instrumentation::ticks() : 0;
+        uint64_t dealTicks = 0;
+        uint64_t evaluateTicks = 0;
+        uint64_t waitTicks = 0;
+        long long workerTrials = 0;
+        long long workerEvaluations = 0;
+        try {
+            std::mt19937 rng(seedBase + 7919u * static_cast<unsigned int>(t));
+            uint8_t deck[52];
+            int remaining = 0;
+            for (int c = 0; c < 52; c++) {
+                if (!dead[c]) deck[remaining++] = static_cast<uint8_t>(c);
+            }
+            uint8_t hero[7];
+            uint8_t opponent[7];
+            for (int i = 0; i < boardSize; i++) {
+                hero[2 + i] = opponent[2 + i] = board[i];
+            }
+
+            HeatmapGrid grid = start;
+            Sums local[HandClass::COUNT];
+            while (!done && isCurrent(requestGeneration)) {
+                // Cellules encore à échantillonner, d'après la dernière fusion vue
+                bool active[HandClass::COUNT];
+                for (int c = 0; c < HandClass::COUNT; c++) {
+                    active[c] = grid.cells[c].possible && !grid.cells[c].converged;
+                    local[c] = Sums();
+                }
+
+                TraceSpan round("heatmap.round", "chunk", roundTrials);
+                for (int trial = 0; trial < roundTrials; trial++) {
+                    const uint64_t dealStart = instrumented ? Instrumentation::ticks() : 0;
+                    uint64_t blocked = 0;
+                    for (int d = 0; d < drawn; d++) {
+                        int j = d + static_cast<int>(rng() % static_cast<unsigned>(remaining - d));
+                        std::swap(deck[d], deck[j]);
+                        blocked |= 1ULL << deck[d];
+                    }
+                    for (int b = 0; b < missingBoard; b++) {
+                        hero[2 + boardSize + b] = opponent[2 + boardSize + b] = deck[b];
+                    }
+
+                    uint64_t evaluateStart = 0;
+                    if (instrumented) {
+                        evaluateStart = Instrumentation::ticks();
+                        dealTicks += evaluateStart - dealStart;
+                    }
+                    
+                    // Tirage partagé: meilleure main adverse évaluée une seule fois pour les 169 cases
+                    int bestOpponent = -1;
+                    for (int o = 0; o < config.numOpponents; o++) {
+                        opponent[0] = deck[missingBoard + 2 * o];
+                        opponent[1] = deck[missingBoard + 2 * o + 1];
+                        bestOpponent = std::max(bestOpponent, HandEvaluator::evaluateScore(opponent, 7));
+                    }
+
+                    for (int c = 0; c < HandClass::COUNT; c++) {
+                        if (!active[c]) continue;
+                        int available[12];
+                        int numFree = 0;
+                        for (int k = 0; k < comboCounts[c]; k++) {
+                            if (!((blocked >> combos[c][k][0]) & 1) && !((blocked >> combos[c][k][1]) & 1)) {
+                                available[numFree++] = k;
+                            }
+                        }
+                        if (numFree == 0) continue;
+
+                        const int k = available[rng() % static_cast<unsigned>(numFree)];
+                        hero[0] = combos[c][k][0];
+                        hero[1] = combos[c][k][1];
+                        const int score = HandEvaluator::evaluateScore(hero, 7);
+                        const double outcome = score > bestOpponent ? 1.0 : (score == bestOpponent ? 0.5 : 0.0);
+
+                        // Poids = combos non bloqués: corrige l'effet des cartes adverses sur la classe
+                        const double weight = numFree;
+                        Sums& sums = local[c];
+                        sums.weight += weight;
+                        sums.weighted += weight * outcome;
+                        sums.weightedSquares += weight * outcome * outcome;
+                        sums.squaredWeights += weight * weight;
+                        sums.samples++;
+                        workerEvaluations++;
+                    }
+                    if (instrumented) {
+                        evaluateTicks += Instrumentation::ticks() - evaluateStart;
+                    }
+                }
+                workerTrials += roundTrials;
+                workerEvaluations += static_cast<long long>(roundTrials) * config.numOpponents;
+
+                const uint64_t lockStart = instrumented ? Instrumentation::ticks() : 0;
+                const int64_t lockTraceStart = Trace::enabled() ? Trace::now() : 0;
+                std::lock_guard<std::mutex> lock(cacheMutex);
+                if (lockTraceStart != 0) {
+                    Trace::record("lock wait", "wait", lockTraceStart, Trace::now());
+                }
+                if (instrumented) {
+                    waitTicks += Instrumentation::ticks() - lockStart;
+                }
+                for (int c = 0; c < HandClass::COUNT; c++) {
+                    Sums& sums = entry->sums[c];
+                    sums.weight += local[c].weight;
+                    sums.weighted += local[c].weighted;
+                    sums.weightedSquares += local[c].weightedSquares;
+                    sums.squaredWeights += local[c].squaredWeights;
+                    sums.samples += local[c].samples;
+                }
+                entry->trials += roundTrials;
+                fillGrid(*entry, config, grid);
+                grid.generation = requestGeneration;
+                grid.fromCache = false;
+                if (grid.final) {
+                    done = true;
+                }
+                if (onUpdate && isCurrent(requestGeneration)) {
+                    onUpdate(grid);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure) failure = std::current_exception();
+            done = true;
+        }
+        // Temps de fusion (sous le verrou, appel de onUpdate compris) compté comme agrégation
+        if (instrumented) {
+            const uint64_t workerTicks = Instrumentation::ticks() - workerStart;
+            Instrumentation::addTrials(workerTrials, workerEvaluations);
+            Instrumentation::addPhase(SolverPhase::DEAL, dealTicks);
+            Instrumentation::addPhase(SolverPhase::EVALUATE, evaluateTicks);
+            Instrumentation::addPhase(SolverPhase::WAIT, waitTicks);
+            const uint64_t accounted = dealTicks + evaluateTicks + waitTicks;
+            Instrumentation::addPhase(SolverPhase::AGGREGATE, workerTicks > accounted ? workerTicks - accounted : 0);
+            Instrumentation::addWorkerTime(workerTicks);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < numThreads; t++) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    // Attente des autres threads par le thread appelant: déséquilibre de fin de calcul
+    const uint64_t joinStart = instrumented ? Instrumentation::ticks() : 0;
+    {
+        TraceSpan join("join workers", "wait");
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+    if (instrumented) {
+        const uint64_t joinTicks = Instrumentation::ticks() - joinStart;
+        Instrumentation::addPhase(SolverPhase::WAIT, joinTicks);
+        Instrumentation::addWorkerTime(joinTicks);
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return done.load();
+}
+
+size_t RangeHeatmap::getCacheSize() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return cache.size();
+}
+
+void RangeHeatmap::clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cache.clear();
+}
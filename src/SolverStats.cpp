@@ -0,0 +1,121 @@
+#include "../include/SolverStats.h"
+#include <iomanip>
+#include <sstream>
+
+std::atomic<bool> Instrumentation::active(false);
+std::atomic<uint64_t> Instrumentation::queries(0);
+std::atomic<uint64_t> Instrumentation::trials(0);
+std::atomic<uint64_t> Instrumentation::evaluations(0);
+std::atomic<uint64_t> Instrumentation::phaseTicks[SolverStats::PHASE_COUNT] = {};
+std::atomic<uint64_t> Instrumentation::cacheHits(0);
+std::atomic<uint64_t> Instrumentation::cacheMisses(0);
+std::atomic<uint64_t> Instrumentation::workerTicks(0);
+std::atomic<uint64_t> Instrumentation::startTicks(0);
+std::atomic<int64_t> Instrumentation::startNanos(0);
+
+const char* SolverStats::phaseName(int phase) {
+    static const char* NAMES[PHASE_COUNT] = {"setup", "deal", "evaluate", "aggregate", "wait"};
+    return phase >= 0 && phase < PHASE_COUNT ? NAMES[phase] : "?";
+}
+
+double SolverStats::cacheHitRate() const {
+    const uint64_t lookups = cacheHits + cacheMisses;
+    return lookups > 0 ? static_cast<double>(cacheHits) / lookups : 0.0;
+}
+
+double SolverStats::threadUtilization() const {
+    if (workerTicks == 0) return 1.0;
+    const uint64_t waiting = phaseTicks[static_cast<int>(SolverPhase::WAIT)];
+    return waiting >= workerTicks ? 0.0 : 1.0 - static_cast<double>(waiting) / workerTicks;
+}
+
+double SolverStats::trialsPerSecond() const {
+    uint64_t busy = 0;
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        if (p != static_cast<int>(SolverPhase::WAIT)) busy += phaseTicks[p];
+    }
+    // Débit rapporté au temps mesuré dans les boucles, pas au temps écoulé
+    return busy > 0 && ticksPerSecond > 0.0 ? trials * ticksPerSecond / busy : 0.0;
+}
+
+std::string SolverStats::toString() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1);
+    oss << "=== Solver Statistics (" << seconds << " s) ===" << std::endl;
+    if (!enabled) {
+        oss << "Instrumentation disabled" << std::endl;
+        return oss.str();
+    }
+    oss << "Queries:      " << queries << std::endl;
+    oss << "Trials:       " << trials << " (" << std::setprecision(0) << trialsPerSecond() << "/s)" << std::endl;
+    oss << "Evaluations:  " << evaluations << std::endl;
+
+    uint64_t total = 0;
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        total += phaseTicks[p];
+    }
+    oss << std::setprecision(1);
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        const double ms = ticksPerSecond > 0.0 ? phaseTicks[p] * 1000.0 / ticksPerSecond : 0.0;
+        oss << "  " << std::left << std::setw(10) << phaseName(p) << std::right << std::setw(10) << ms << " ms "
+            << std::setw(5) << (total > 0 ? phaseTicks[p] * 100.0 / total : 0.0) << "%";
+        if (trials > 0 && p != static_cast<int>(SolverPhase::WAIT)) {
+            oss << "  " << std::setw(7) << static_cast<double>(phaseTicks[p]) / trials << " ticks/trial";
+        }
+        oss << std::endl;
+    }
+    oss << "Cache:        " << cacheHits << " hits / " << cacheMisses << " misses ("
+        << cacheHitRate() * 100.0 << "%)" << std::endl;
+    oss << "Threads:      " << threadUtilization() * 100.0 << "% utilization" << std::endl;
+    return oss.str();
+}
+
+int64_t Instrumentation::nanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Instrumentation::setEnabled(bool on) {
+    if (on && !enabled()) {
+        reset();
+    }
+    active.store(on);
+}
+
+void Instrumentation::reset() {
+    queries = 0;
+    trials = 0;
+    evaluations = 0;
+    for (auto& phase : phaseTicks) {
+        phase = 0;
+    }
+    cacheHits = 0;
+    cacheMisses = 0;
+    workerTicks = 0;
+    startTicks = ticks();
+    startNanos = nanos();
+}
+
+SolverStats Instrumentation::stats() {
+    SolverStats snapshot;
+    snapshot.enabled = enabled();
+    snapshot.queries = queries.load();
+    snapshot.trials = trials.load();
+    snapshot.evaluations = evaluations.load();
+    for (int p = 0; p < SolverStats::PHASE_COUNT; p++) {
+        snapshot.phaseTicks[p] = phaseTicks[p].load();
+    }
+    snapshot.cacheHits = cacheHits.load();
+    snapshot.cacheMisses = cacheMisses.load();
+    snapshot.workerTicks = workerTicks.load();
+
+    // Fréquence des ticks mesurée sur la période écoulée depuis la remise à zéro
+    if (startNanos.load() == 0) {
+        return snapshot;
+    }
+    const int64_t elapsedNanos = nanos() - startNanos.load();
+    const uint64_t elapsedTicks = ticks() - startTicks.load();
+    snapshot.seconds = elapsedNanos / 1e9;
+    snapshot.ticksPerSecond = elapsedNanos > 0 ? elapsedTicks * 1e9 / elapsedNanos : 0.0;
+    return snapshot;
+}
@@ -0,0 +1,473 @@
+#include "../include/TableBatch.h"
+#include "HandEvaluator.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+const uint8_t STATUS_ACTIVE = static_cast<uint8_t>(PlayerStatus::ACTIVE);
+const uint8_t STATUS_FOLDED = static_cast<uint8_t>(PlayerStatus::FOLDED);
+const uint8_t STATUS_ALL_IN = static_cast<uint8_t>(PlayerStatus::ALL_IN);
+
+} // namespace
+
+HandStrengthBatchAgent::HandStrengthBatchAgent(HandRank value, HandRank call)
+    : valueRank(value), callRank(call) {
+}
+
+void HandStrengthBatchAgent::act(const TableBatch& batch, int seat, const int* tables, int count, Action* actions) {
+    for (int i = 0; i < count; i++) {
+        int table = tables[i];
+        int toCall = batch.toCall(table, seat);
+
+        if (batch.phase(table) == GamePhase::PRE_FLOP) {
+            actions[i] = toCall > 0 ? Action::call() : Action::check();
+            continue;
+        }
+
+        HandRank rank = HandEvaluator::rankOfScore(batch.handScore(table, seat));
+        if (rank >= valueRank && batch.canRaise(table, seat)) {
+            // Relance de la taille du pot
+            int target = batch.currentBet(table) + batch.pot(table) + toCall;
+            target = std::max(batch.minRaiseTo(table, seat), std::min(target, batch.maxRaiseTo(table, seat)));
+            actions[i] = batch.currentBet(table) > 0 ? Action::raiseTo(target) : Action::bet(target);
+        } else if (toCall == 0) {
+            actions[i] = Action::check();
+        } else {
+            actions[i] = rank >= callRank ? Action::call() : Action::fold();
+        }
+    }
+}
+
+TableBatch::TableBatch(int tables, int players, int sb, int bb, int stack, unsigned int seed)
+    : numTables(tables), numPlayers(players), smallBlind(sb), bigBlind(bb), startingStack(stack),
+      rng(seed), handsPlayed(0) {
+
+    if (tables <= 0) {
+        throw std::invalid_argument("At least one table required");
+    }
+    if (players < 2 || players > MAX_PLAYERS) {
+        throw std::invalid_argument("Number of players must be between 2 and 9");
+    }
+    if (sb <= 0 || bb < sb || stack <= 0) {
+        throw std::invalid_argument("Invalid blinds or stack");
+    }
+
+    const size_t seats = static_cast<size_t>(tables) * players;
+    agents.assign(players, nullptr);
+
+    stacks.assign(seats, 0);
+    streetBets.assign(seats, 0);
+    committed.assign(seats, 0);
+    statuses.assign(seats, STATUS_FOLDED);
+    holeCards.assign(2 * seats, 0);
+    handScores.assign(seats, 0);
+
+    decks.resize(52 * static_cast<size_t>(tables));
+    for (int t = 0; t < tables; t++) {
+        for (int c = 0; c < 52; c++) {
+            decks[52 * t + c] = static_cast<uint8_t>(c);
+        }
+    }
+    boards.assign(5 * static_cast<size_t>(tables), 0);
+    boardSizes.assign(tables, 0);
+    phases.assign(tables, static_cast<uint8_t>(GamePhase::SHOWDOWN));
+    dealers.resize(tables);
+    for (int t = 0; t < tables; t++) {
+        // Boutons décalés d'une table à l'autre; startHands() les avance avant chaque main
+        dealers[t] = static_cast<uint8_t>((t + players - 1) % players);
+    }
+    toAct.assign(tables, -1);
+    currentBets.assign(tables, 0);
+    lastRaises.assign(tables, bb);
+    needsToAct.assign(tables, 0);
+    canReopen.assign(tables, 0);
+    awaitingShowdown.assign(tables, 0);
+
+    tablesBySeat.resize(players);
+    for (auto& list : tablesBySeat) {
+        list.reserve(tables);
+    }
+    actionScratch.reserve(tables);
+    evalCards.reserve(7 * seats);
+    evalCounts.reserve(seats);
+    evalScores.reserve(seats);
+    evalOwners.reserve(seats);
+
+    netResults.assign(players, 0);
+}
+
+void TableBatch::setAgent(int seat, BatchAgent* agent) {
+    agents.at(seat) = agent;
+}
+
+void TableBatch::startHands() {
+    const int cardsNeeded = 2 * numPlayers + 5;
+
+    for (int t = 0; t < numTables; t++) {
+        const int base = t * numPlayers;
+        dealers[t] = static_cast<uint8_t>((dealers[t] + 1) % numPlayers);
+
+        for (int s = 0; s < numPlayers; s++) {
+            stacks[base + s] = startingStack;
+            streetBets[base + s] = 0;
+            committed[base + s] = 0;
+            statuses[base + s] = STATUS_ACTIVE;
+            handScores[base + s] = 0;
+        }
+
+        // Mélange partiel: seules les cartes distribuées sont tirées
+        uint8_t* deck = &decks[52 * t];
+        for (int i = 0; i < cardsNeeded; i++) {
+            uint32_t remaining = 52 - i;
+            int j = i + static_cast<int>((static_cast<uint64_t>(rng()) * remaining) >> 32);
+            std::swap(deck[i], deck[j]);
+        }
+        for (int s = 0; s < numPlayers; s++) {
+            holeCards[2 * (base + s)] = deck[2 * s];
+            holeCards[2 * (base + s) + 1] = deck[2 * s + 1];
+        }
+        for (int i = 0; i < 5; i++) {
+            boards[5 * t + i] = deck[2 * numPlayers + i];
+        }
+        boardSizes[t] = 0;
+        phases[t] = static_cast<uint8_t>(GamePhase::PRE_FLOP);
+        awaitingShowdown[t] = 0;
+
+        // Blinds (en tête-à-tête, le donneur poste la petite blind)
+        int dealerSeat = dealers[t];
+        int sbSeat = numPlayers == 2 ? dealerSeat : (dealerSeat + 1) % numPlayers;
+        int bbSeat = (sbSeat + 1) % numPlayers;
+        commitChips(t, sbSeat, std::min(smallBlind, stacks[base + sbSeat]));
+        commitChips(t, bbSeat, std::min(bigBlind, stacks[base + bbSeat]));
+        currentBets[t] = bigBlind;
+        lastRaises[t] = bigBlind;
+
+        uint16_t everyone = 0;
+        for (int s = 0; s < numPlayers; s++) {
+            if (statuses[base + s] == STATUS_ACTIVE) everyone |= 1u << s;
+        }
+        needsToAct[t] = everyone;
+        canReopen[t] = static_cast<uint16_t>((1u << numPlayers) - 1);
+
+        advance(t, (bbSeat + 1) % numPlayers);
+    }
+
+    flushEvaluations();
+}
+
+bool TableBatch::step() {
+    for (auto& list : tablesBySeat) {
+        list.clear();
+    }
+    for (int t = 0; t < numTables; t++) {
+        if (toAct[t] >= 0) {
+            tablesBySeat[toAct[t]].push_back(t);
+        }
+    }
+
+    for (int seat = 0; seat < numPlayers; seat++) {
+        const std::vector<int>& waiting = tablesBySeat[seat];
+        const int count = static_cast<int>(waiting.size());
+        if (count == 0) continue;
+
+        actionScratch.resize(count);
+        if (agents[seat]) {
+            agents[seat]->act(*this, seat, waiting.data(), count, actionScratch.data());
+        } else {
+            for (int i = 0; i < count; i++) {
+                actionScratch[i] = toCall(waiting[i], seat) > 0 ? Action::call() : Action::check();
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            applyAction(waiting[i], seat, actionScratch[i]);
+            advance(waiting[i], (seat + 1) % numPlayers);
+        }
+    }
+
+    flushEvaluations();
+
+    for (int t = 0; t < numTables; t++) {
+        if (toAct[t] >= 0) return true;
+    }
+    return false;
+}
+
+void TableBatch::playHands() {
+    startHands();
+    while (step()) {
+    }
+}
+
+int TableBatch::pot(int table) const {
+    int total = 0;
+    const int base = table * numPlayers;
+    for (int s = 0; s < numPlayers; s++) {
+        total += committed[base + s];
+    }
+    return total;
+}
+
+int TableBatch::toCall(int table, int seat) const {
+    return std::max(0, currentBets[table] - streetBets[table * numPlayers + seat]);
+}
+
+bool TableBatch::canRaise(int table, int seat) const {
+    const int idx = table * numPlayers + seat;
+    return statuses[idx] == STATUS_ACTIVE && (canReopen[table] & (1u << seat))
+        && streetBets[idx] + stacks[idx] > currentBets[table];
+}
+
+int TableBatch::minRaiseTo(int table, int seat) const {
+    return std::min(currentBets[table] + lastRaises[table], maxRaiseTo(table, seat));
+}
+
+int TableBatch::maxRaiseTo(int table, int seat) const {
+    const int idx = table * numPlayers + seat;
+    return streetBets[idx] + stacks[idx];
+}
+
+void TableBatch::applyAction(int table, int seat, const Action& action) {
+    const int idx = table * numPlayers + seat;
+    if (statuses[idx] != STATUS_ACTIVE) {
+        throw std::invalid_argument("Seat cannot act");
+    }
+
+    const int bet = currentBets[table];
+    const int playerBet = streetBets[idx];
+    const int maxTotal = playerBet + stacks[idx];
+
+    ActionType type = action.type;
+    int total = action.amount;
+
+    if (type == ActionType::ALL_IN) {
+        total = maxTotal;
+        if (maxTotal <= bet) {
+            type = ActionType::CALL;
+        } else {
+            type = bet > 0 ? ActionType::RAISE : ActionType::BET;
+        }
+    }
+
+    switch (type) {
+        case ActionType::FOLD:
+            statuses[idx] = STATUS_FOLDED;
+            break;
+
+        case ActionType::CHECK:
+            if (bet > playerBet) {
+                throw std::invalid_argument("Cannot check facing a bet");
+            }
+            break;
+
+        case ActionType::CALL:
+            if (bet <= playerBet) {
+                throw std::invalid_argument("Nothing to call, check instead");
+            }
+            commitChips(table, seat, std::min(bet, maxTotal) - playerBet);
+            break;
+
+        case ActionType::BET:
+        case ActionType::RAISE: {
+            if (type == ActionType::BET && bet > 0) {
+                throw std::invalid_argument("Cannot bet facing a bet, raise instead");
+            }
+            if (type == ActionType::RAISE && bet == 0) {
+                throw std::invalid_argument("Nothing to raise, bet instead");
+            }
+            if (!(canReopen[table] & (1u << seat))) {
+                throw std::invalid_argument("Betting is not reopened for this player");
+            }
+            if (total <= bet || total > maxTotal) {
+                throw std::invalid_argument("Bet amount out of range");
+            }
+
+            int increment = total - bet;
+            if (increment < lastRaises[table] && total < maxTotal) {
+                throw std::invalid_argument("Bet below the minimum raise");
+            }
+
+            commitChips(table, seat, total - playerBet);
+            currentBets[table] = total;
+
+            uint16_t others = 0;
+            for (int s = 0; s < numPlayers; s++) {
+                if (s != seat && statuses[table * numPlayers + s] == STATUS_ACTIVE) others |= 1u << s;
+            }
+            needsToAct[table] |= others;
+            if (increment >= lastRaises[table]) {
+                lastRaises[table] = increment;
+                canReopen[table] |= others;
+            }
+            break;
+        }
+
+        case ActionType::ALL_IN:
+            break;
+    }
+
+    needsToAct[table] &= static_cast<uint16_t>(~(1u << seat));
+    canReopen[table] &= static_cast<uint16_t>(~(1u << seat));
+}
+
+void TableBatch::advance(int table, int from) {
+    const int base = table * numPlayers;
+
+    for (;;) {
+        if (playersInHand(table) <= 1) {
+            finishHand(table);
+            return;
+        }
+
+        int seat = -1;
+        for (int i = 0; i < numPlayers; i++) {
+            int s = (from + i) % numPlayers;
+            if ((needsToAct[table] & (1u << s)) && statuses[base + s] == STATUS_ACTIVE) {
+                seat = s;
+                break;
+            }
+        }
+
+        if (seat >= 0) {
+            // Seul joueur avec des jetons et rien à payer: plus personne contre qui miser
+            if (playersWithChips(table) == 1 && streetBets[base + seat] >= currentBets[table]) {
+                needsToAct[table] &= static_cast<uint16_t>(~(1u << seat));
+                continue;
+            }
+            toAct[table] = static_cast<int8_t>(seat);
+            return;
+        }
+
+        // Tour d'enchères terminé
+        toAct[table] = -1;
+        if (phases[table] == static_cast<uint8_t>(GamePhase::RIVER)) {
+            awaitingShowdown[table] = 1;
+            return;
+        }
+        dealStreet(table);
+        startStreet(table);
+        from = (dealers[table] + 1) % numPlayers;
+    }
+}
+
+void TableBatch::startStreet(int table) {
+    const int base = table * numPlayers;
+    uint16_t active = 0;
+    for (int s = 0; s < numPlayers; s++) {
+        streetBets[base + s] = 0;
+        if (statuses[base + s] == STATUS_ACTIVE) active |= 1u << s;
+    }
+    currentBets[table] = 0;
+    lastRaises[table] = bigBlind;
+    needsToAct[table] = active;
+    canReopen[table] = static_cast<uint16_t>((1u << numPlayers) - 1);
+}
+
+void TableBatch::dealStreet(int table) {
+    GamePhase current = static_cast<GamePhase>(phases[table]);
+    boardSizes[table] = current == GamePhase::PRE_FLOP ? 3 : boardSizes[table] + 1;
+    phases[table] = static_cast<uint8_t>(current == GamePhase::PRE_FLOP ? GamePhase::FLOP
+                                         : current == GamePhase::FLOP ? GamePhase::TURN
+                                         : GamePhase::RIVER);
+
+    // Mains encore en jeu: évaluées toutes ensemble à la fin du step
+    const int base = table * numPlayers;
+    const int boardCount = boardSizes[table];
+    for (int s = 0; s < numPlayers; s++) {
+        if (statuses[base + s] == STATUS_FOLDED) continue;
+        evalCards.push_back(holeCards[2 * (base + s)]);
+        evalCards.push_back(holeCards[2 * (base + s) + 1]);
+        for (int i = 0; i < 5; i++) {
+            evalCards.push_back(i < boardCount ? boards[5 * table + i] : 0);
+        }
+        evalCounts.push_back(static_cast<uint8_t>(2 + boardCount));
+        evalOwners.push_back(base + s);
+    }
+}
+
+void TableBatch::flushEvaluations() {
+    const int count = static_cast<int>(evalCounts.size());
+    if (count > 0) {
+        evalScores.resize(count);
+        HandEvaluator::evaluateScores(evalCards.data(), evalCounts.data(), count, evalScores.data());
+        for (int i = 0; i < count; i++) {
+            handScores[evalOwners[i]] = evalScores[i];
+        }
+        evalCards.clear();
+        evalCounts.clear();
+        evalOwners.clear();
+    }
+
+    for (int t = 0; t < numTables; t++) {
+        if (awaitingShowdown[t]) {
+            awaitingShowdown[t] = 0;
+            showdown(t);
+        }
+    }
+}
+
+void TableBatch::finishHand(int table) {
+    const int base = table * numPlayers;
+    const int total = pot(table);
+    for (int s = 0; s < numPlayers; s++) {
+        int won = statuses[base + s] != STATUS_FOLDED ? total : 0;
+        netResults[s] += won - committed[base + s];
+    }
+    phases[table] = static_cast<uint8_t>(GamePhase::SHOWDOWN);
+    toAct[table] = -1;
+    handsPlayed++;
+}
+
+void TableBatch::showdown(int table) {
+    const int base = table * numPlayers;
+
+    uint16_t liveSeats = 0;
+    for (int s = 0; s < numPlayers; s++) {
+        if (statuses[base + s] != STATUS_FOLDED) liveSeats |= 1u << s;
+    }
+
+    PotManager pots;
+    pots.calculatePots(&committed[base], liveSeats, numPlayers);
+
+    int won[MAX_PLAYERS];
+    pots.distributePots(&handScores[base], (dealers[table] + 1) % numPlayers, won);
+
+    for (int s = 0; s < numPlayers; s++) {
+        netResults[s] += won[s] - committed[base + s];
+    }
+    phases[table] = static_cast<uint8_t>(GamePhase::SHOWDOWN);
+    toAct[table] = -1;
+    handsPlayed++;
+}
+
+void TableBatch::commitChips(int table, int seat, int chips) {
+    const int idx = table * numPlayers + seat;
+    if (chips <= 0) return;
+
+    if (chips >= stacks[idx]) {
+        chips = stacks[idx];
+        statuses[idx] = STATUS_ALL_IN;
+    }
+    stacks[idx] -= chips;
+    streetBets[idx] += chips;
+    committed[idx] += chips;
+}
+
+int TableBatch::playersInHand(int table) const {
+    int count = 0;
+    const int base = table * numPlayers;
+    for (int s = 0; s < numPlayers; s++) {
+        if (statuses[base + s] != STATUS_FOLDED) count++;
+    }
+    return count;
+}
+
+int TableBatch::playersWithChips(int table) const {
+    int count = 0;
+    const int base = table * numPlayers;
+    for (int s = 0; s < numPlayers; s++) {
+        if (statuses[base + s] == STATUS_ACTIVE) count++;
+    }
+    return count;
+}
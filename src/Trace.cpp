@@ -0,0 +1,225 @@
+#include "../include/Trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // Champs atomiques relâchés: l'exportateur peut lire un emplacement que le propriétaire réécrit
+    struct EventSlot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<const char*> category{nullptr};
+        std::atomic<int64_t> startNanos{0};
+        std::atomic<int64_t> endNanos{0};
+        std::atomic<int64_t> value{-1};
+        std::atomic<uint32_t> thread{0};
+
+        void store(const TraceEvent& event) {
+            name.store(event.name, std::memory_order_relaxed);
+            category.store(event.category, std::memory_order_relaxed);
+            startNanos.store(event.startNanos, std::memory_order_relaxed);
+            endNanos.store(event.endNanos, std::memory_order_relaxed);
+            value.store(event.value, std::memory_order_relaxed);
+            thread.store(event.thread, std::memory_order_relaxed);
+        }
+
+        TraceEvent load() const {
+            TraceEvent event;
+            event.name = name.load(std::memory_order_relaxed);
+            event.category = category.load(std::memory_order_relaxed);
+            event.startNanos = startNanos.load(std::memory_order_relaxed);
+            event.endNanos = endNanos.load(std::memory_order_relaxed);
+            event.value = value.load(std::memory_order_relaxed);
+            event.thread = thread.load(std::memory_order_relaxed);
+            return event;
+        }
+    };
+
+    struct RingBuffer {
+        EventSlot events[Trace::BUFFER_EVENTS];
+        std::atomic<uint64_t> written{0};  // Events ever recorded, published by the owner
+        std::atomic<uint64_t> floor{0};    // First event kept since the last clear()
+    };
+
+    // Registre des tampons: verrou seulement à l'acquisition d'un tampon par un thread
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<RingBuffer>> buffers;
+        std::vector<RingBuffer*> available;
+        std::atomic<uint32_t> nextThread{1};
+    };
+
+    Registry& registry() {
+        // Jamais détruit: des threads peuvent encore rendre leur tampon à la sortie du programme
+        static Registry* instance = new Registry();
+        return *instance;
+    }
+
+    struct ThreadSlot {
+        RingBuffer* buffer = nullptr;
+        uint32_t thread = 0;
+
+        ~ThreadSlot() {
+            if (buffer) {
+                Registry& reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                reg.available.push_back(buffer);
+            }
+        }
+    };
+
+    thread_local ThreadSlot threadSlot;
+
+    void acquireBuffer(ThreadSlot& slot) {
+        Registry& reg = registry();
+        slot.thread = reg.nextThread++;
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.available.empty()) {
+            slot.buffer = reg.available.back();
+            reg.available.pop_back();
+        } else {
+            reg.buffers.push_back(std::unique_ptr<RingBuffer>(new RingBuffer()));
+            slot.buffer = reg.buffers.back().get();
+        }
+    }
+
+    // Copie des événements encore valides de chaque tampon
+    std::vector<TraceEvent> collect() {
+        Registry& reg = registry();
+        std::vector<TraceEvent> events;
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& buffer : reg.buffers) {
+            const uint64_t head = buffer->written.load(std::memory_order_acquire);
+            const uint64_t first = std::max(buffer->floor.load(),
+                                            head > Trace::BUFFER_EVENTS ? head - Trace::BUFFER_EVENTS : 0);
+            const size_t start = events.size();
+            for (uint64_t i = first; i < head; i++) {
+                events.push_back(buffer->events[i % Trace::BUFFER_EVENTS].load());
+            }
+
+            // Le propriétaire a pu écraser le début pendant la copie: ces événements sont écartés.
+            // La barrière ordonne la copie avant la relecture du compteur (verrou de séquence):
+            // si une valeur réécrite a été lue, le compteur relu couvre sa réécriture.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t after = buffer->written.load(std::memory_order_relaxed);
+            if (after + 1 > first + Trace::BUFFER_EVENTS) {
+                const uint64_t overwritten = std::min(head, after + 1 - Trace::BUFFER_EVENTS) - first;
+                events.erase(events.begin() + start, events.begin() + start + static_cast<size_t>(overwritten));
+            }
+        }
+        return events;
+    }
+
+    void appendEscaped(std::ostringstream& oss, const char* text) {
+        for (const char* c = text ? text : ""; *c; c++) {
+            if (*c == '"' || *c == '\\') oss << '\\';
+            oss << *c;
+        }
+    }
+
+    // Événements complets ("X"), triés par début, temps relatifs au premier
+    std::string chromeJson(size_t& count) {
+        std::vector<TraceEvent> events = collect();
+        std::sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+            return a.startNanos < b.startNanos;
+        });
+        const int64_t origin = events.empty() ? 0 : events.front().startNanos;
+
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+        oss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (size_t i = 0; i < events.size(); i++) {
+            const TraceEvent& event = events[i];
+            oss << (i > 0 ? ",\n" : "\n") << "{\"name\":\"";
+            appendEscaped(oss, event.name);
+            oss << "\",\"cat\":\"";
+            appendEscaped(oss, event.category);
+            oss << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+                << ",\"ts\":" << (event.startNanos - origin) / 1000.0
+                << ",\"dur\":" << (event.endNanos - event.startNanos) / 1000.0;
+            if (event.value >= 0) {
+                oss << ",\"args\":{\"value\":" << event.value << "}";
+            }
+            oss << "}";
+        }
+        oss << "\n]}\n";
+        count = events.size();
+        return oss.str();
+    }
+}
+
+std::atomic<bool> Trace::active(false);
+
+void Trace::setEnabled(bool on) {
+    active.store(on);
+}
+
+void Trace::clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& buffer : reg.buffers) {
+        buffer->floor.store(buffer->written.load(std::memory_order_acquire));
+    }
+}
+
+int64_t Trace::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Trace::record(const char* name, const char* category, int64_t startNanos, int64_t endNanos, int64_t value) {
+    ThreadSlot& slot = threadSlot;
+    if (!slot.buffer) {
+        acquireBuffer(slot);
+    }
+    RingBuffer& buffer = *slot.buffer;
+    const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    // Publication précédente ordonnée avant la réécriture de l'emplacement (pendant de la barrière de collect)
+    std::atomic_thread_fence(std::memory_order_release);
+    TraceEvent event;
+    event.name = name;
+    event.category = category;
+    event.startNanos = startNanos;
+    event.endNanos = endNanos;
+    event.value = value;
+    event.thread = slot.thread;
+    buffer.events[index % BUFFER_EVENTS].store(event);
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+size_t Trace::eventCount() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t count = 0;
+    for (const auto& buffer : reg.buffers) {
+        const uint64_t head = buffer->written.load(std::memory_order_acquire);
+        const uint64_t first = std::max(buffer->floor.load(),
+                                        head > BUFFER_EVENTS ? head - BUFFER_EVENTS : 0);
+        count += static_cast<size_t>(head - first);
+    }
+    return count;
+}
+
+std::string Trace::toChromeJson() {
+    size_t count = 0;
+    return chromeJson(count);
+}
+
+size_t Trace::writeChromeJson(const std::string& path) {
+    size_t count = 0;
+    const std::string json = chromeJson(count);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot write trace file: " + path);
+    }
+    out << json;
+    if (!out) {
+        throw std::runtime_error("Cannot write trace file: " + path);
+    }
+    return count;
+}
@@ -2,11 +2,24 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <cctype>
+#include <algorithm>
 #include "Card.h"
 #include "Deck.h"
 #include "HandEvaluator.h"
 #include "../include/PokerSolver.h"
 #include "PokerGame.h"
+#include "FlopReport.h"
+#include "PushFoldSolver.h"
+#include "PokerAgents.h"
+#include "MatchRunner.h"
+#include "HandHistoryImporter.h"
+#include "AllInAnalyzer.h"
+#include "PlayerStats.h"
+#include "SolverStats.h"
+#include "Trace.h"
+#include <cstring>
+#include <fstream>
 
 /**
  * @brief Fonction utilitaire pour parser les cartes depuis une chaîne
@@ -38,7 +51,13 @@ void displayMenu() {
     std::cout << "2. Test de l'evaluateur de mains" << std::endl;
     std::cout << "3. Simulation Monte Carlo simple" << std::endl;
     std::cout << "4. Exemples de scenarios pre-configures" << std::endl;
-    std::cout << "5. Quitter" << std::endl;
+    std::cout << "5. Rapport de flops (batch sur les 1755 flops)" << std::endl;
+    std::cout << "6. Push/Fold - tapis ou passe (stacks courts)" << std::endl;
+    std::cout << "7. Match entre bots (auto-jeu duplicate)" << std::endl;
+    std::cout << "8. Importer un historique PokerStars" << std::endl;
+    std::cout << "9. Chance a tapis (EV ajustee des mains importees)" << std::endl;
+    std::cout << "10. Statistiques des joueurs (journal de mains)" << std::endl;
+    std::cout << "11. Quitter" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "Choix: ";
 }
@@ -88,6 +107,35 @@ void scenarioMode() {
     std::cout << "Nombre d'adversaires actifs: ";
     std::cin >> numOpponents;
     
+    // Mode tournoi (ICM)
+    std::string icmChoice;
+    std::cout << "Tournoi - analyse en equite de prix ICM ($EV)? (o/n): ";
+    std::cin >> icmChoice;
+    bool icmMode = !icmChoice.empty() && (icmChoice[0] == 'o' || icmChoice[0] == 'O');
+    
+    std::vector<int> stacks;
+    std::vector<double> payouts;
+    int heroSeat = 0, villainSeat = 1;
+    
+    if (icmMode) {
+        std::cout << "Stacks de tous les joueurs, hors pot (ex: 1500 3000 2200): ";
+        std::cin.ignore();
+        std::getline(std::cin, input);
+        std::istringstream stackStream(input);
+        for (int stack; stackStream >> stack;) stacks.push_back(stack);
+        
+        std::cout << "Votre siege et celui de l'adversaire qui a mise (1 a " << stacks.size() << ", ex: 1 2): ";
+        std::cin >> heroSeat >> villainSeat;
+        heroSeat--;
+        villainSeat--;
+        
+        std::cout << "Prix par place, du premier au dernier paye (ex: 50 30 20): ";
+        std::cin.ignore();
+        std::getline(std::cin, input);
+        std::istringstream payoutStream(input);
+        for (double prize; payoutStream >> prize;) payouts.push_back(prize);
+    }
+    
     // Analyse
     std::cout << "\n=== ANALYSE EN COURS ===" << std::endl;
     std::cout << "Vos cartes: ";
@@ -108,9 +156,16 @@ void scenarioMode() {
     
     // Calculer avec le solver
     PokerSolver solver(10000);
-    DecisionResult result = solver.analyzeDecision(holeCards, board, potSize, callAmount, numOpponents);
-    
-    std::cout << "\n" << result.toString() << std::endl;
+    try {
+        DecisionResult result = icmMode
+            ? solver.analyzeDecisionICM(holeCards, board, potSize, callAmount, numOpponents,
+                                        stacks, heroSeat, villainSeat, payouts)
+            : solver.analyzeDecision(holeCards, board, potSize, callAmount, numOpponents);
+        
+        std::cout << "\n" << result.toString() << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Erreur: " << e.what() << std::endl;
+    }
 }
 
 /**
@@ -275,10 +330,261 @@ void preConfiguredScenarios() {
     }
 }
 
+/**
+ * @brief Rapport de flops - un matchup sur tous les flops canoniques
+ */
+void flopReportMode() {
+    std::cout << "\n=== RAPPORT DE FLOPS ===" << std::endl;
+
+    FlopReportConfig config;
+    std::string input;
+
+    std::cout << "Main du heros (ex: AKs, QQ, T9o): ";
+    std::cin >> config.heroHand;
+
+    std::cout << "Main adverse (ex: JJ) ou nombre d'adversaires aleatoires (1-9): ";
+    std::cin >> input;
+    if (!input.empty() && std::isdigit(static_cast<unsigned char>(input[0]))) {
+        config.numOpponents = std::stoi(input);
+    } else {
+        config.villainHand = input;
+    }
+
+    std::cout << "Simulations par flop: ";
+    std::cin >> config.simulations;
+
+    std::cout << "Fichier de resultats (ex: flop_report.csv): ";
+    std::cin >> config.outputPath;
+
+    try {
+        FlopReport report(config);
+        int solved = report.run([](int done, int total) {
+            if (done % 50 == 0 || done == total) {
+                std::cout << "  " << done << " / " << total << " flops" << std::endl;
+            }
+        });
+
+        std::cout << "\n" << solved << " flops calcules (les flops deja presents sont repris)." << std::endl;
+        std::cout << "\n" << FlopReport::aggregate(config.outputPath).toString() << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Erreur: " << e.what() << std::endl;
+    }
+}
+
+/**
+ * @brief Push/Fold - ranges de tapis/call d'equilibre par profondeur de stack
+ */
+void pushFoldMode() {
+    std::cout << "\n=== PUSH/FOLD (EQUILIBRE DE NASH) ===" << std::endl;
+
+    PushFoldConfig config;
+    double minStack, maxStack, step;
+
+    std::cout << "Nombre de joueurs (2-9): ";
+    std::cin >> config.numPlayers;
+
+    std::cout << "Ante (en big blinds, 0 = aucune): ";
+    std::cin >> config.ante;
+
+    std::cout << "Stack minimum, maximum et pas (en big blinds, ex: 5 20 1): ";
+    std::cin >> minStack >> maxStack >> step;
+
+    try {
+        PushFoldSolver solver;
+        std::cout << "\nPreparation de la table d'equites preflop (mise en cache au premier lancement)..." << std::endl;
+
+        for (const auto& result : solver.solveChart(config, minStack, maxStack, step)) {
+            std::cout << "\n" << result.toString();
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Erreur: " << e.what() << std::endl;
+    }
+}
+
+/**
+ * @brief Match entre bots - taux de gain en bb/100 avec intervalle de confiance
+ */
+void matchMode() {
+    std::cout << "\n=== MATCH ENTRE BOTS ===" << std::endl;
+
+    MatchConfig config;
+    int numAgents;
+    std::string jsonPath;
+
+    std::cout << "Nombre de joueurs (2-9): ";
+    std::cin >> numAgents;
+
+    std::cout << "Nombre de donnes: ";
+    std::cin >> config.deals;
+
+    config.reportEvery = std::max(1LL, config.deals / 10);
+
+    try {
+        MatchRunner runner(config);
+
+        for (int i = 0; i < numAgents; i++) {
+            int type;
+            std::cout << "Bot " << (i + 1) << " (1 = suiveur check/call, 2 = aleatoire passif, 3 = aleatoire agressif): ";
+            std::cin >> type;
+
+            std::string name = "Bot " + std::to_string(i + 1);
+            if (type == 1) {
+                runner.addAgent(name + " (suiveur)", [](unsigned int) {
+                    return std::unique_ptr<PokerAgent>(new CallingStationAgent());
+                });
+            } else {
+                double raise = type == 3 ? 0.5 : 0.15;
+                runner.addAgent(name + (type == 3 ? " (agressif)" : " (passif)"), [raise](unsigned int seed) {
+                    return std::unique_ptr<PokerAgent>(new RandomAgent(0.3, raise, seed));
+                });
+            }
+        }
+
+        std::cout << "Fichier JSON du resume (- = aucun): ";
+        std::cin >> jsonPath;
+
+        MatchResult result = runner.run([](const MatchResult& progress) {
+            std::cout << "  " << progress.deals << " donnes, " << progress.hands << " mains" << std::endl;
+        });
+
+        std::cout << "\n" << result.toString();
+
+        if (jsonPath != "-") {
+            std::ofstream out(jsonPath);
+            out << result.toJson();
+            std::cout << "Resume ecrit dans " << jsonPath << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Erreur: " << e.what() << std::endl;
+    }
+}
+
+/**
+ * @brief Import d'historiques PokerStars vers un fichier d'enregistrements binaires
+ */
+void importMode() {
+    std::cout << "\n=== IMPORT D'HISTORIQUE POKERSTARS ===" << std::endl;
+
+    std::string historyPath, outputPath;
+    std::cout << "Fichier d'historique: ";
+    std::cin >> historyPath;
+    std::cout << "Fichier de sortie (.pshh ou .phl): ";
+    std::cin >> outputPath;
+
+    try {
+        HandHistoryImporter importer;
+        ImportStats stats = importer.importFile(historyPath, outputPath, [](long long done, long long total) {
+            std::cout << "  " << (done * 100 / std::max(1LL, total)) << "%" << std::endl;
+        });
+
+        std::cout << "\nMains importees: " << stats.hands << std::endl;
+        std::cout << "Mains ignorees (autres jeux, tableau double, illisibles): " << stats.skipped << std::endl;
+        std::cout << "Duree: " << stats.seconds << " s (" << stats.megabytesPerSecond() << " Mo/s)" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Erreur: " << e.what() << std::endl;
+    }
+}
+
+/**
+ * @brief Chance a tapis - gains reels contre EV au moment du tapis
+ */
+void allInLuckMode() {
+    std::cout << "\n=== CHANCE A TAPIS ===" << std::endl;
+
+    AllInConfig config;
+    std::string recordPath, csvPath;
+    std::cout << "Fichier de mains importees (.pshh ou .phl): ";
+    std::cin >> recordPath;
+    std::cout << "Joueur (- = le heros de chaque main): ";
+    std::cin >> config.player;
+    if (config.player == "-") config.player.clear();
+    std::cout << "Fichier CSV des sessions (- = aucun): ";
+    std::cin >> csvPath;
+
+    try {
+        AllInAnalyzer analyzer(config);
+        LuckReport report = analyzer.analyze(recordPath, [](long long done, long long total) {
+            if (done % 100 == 0 || done == total) {
+                std::cout << "  " << done << "/" << total << " spots enumeres" << std::endl;
+            }
+        });
+
+        std::cout << "\n" << report.toString();
+
+        if (csvPath != "-") {
+            report.writeCsv(csvPath);
+            std::cout << "Sessions ecrites dans " << csvPath << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Erreur: " << e.what() << std::endl;
+    }
+}
+
+/**
+ * @brief Statistiques des joueurs - VPIP, PFR, 3-bet, c-bet, abattages par groupe
+ */
+void playerStatsMode() {
+    std::cout << "\n=== STATISTIQUES DES JOUEURS ===" << std::endl;
+
+    StatsQuery query;
+    std::string logPath, groups, csvPath;
+    std::cout << "Journal de mains (.phl): ";
+    std::cin >> logPath;
+    std::cout << "Regrouper par (j=joueur, p=position, s=profondeur, t=texture du flop, - = rien, ex: jp): ";
+    std::cin >> groups;
+    for (char c : groups) {
+        switch (std::tolower(static_cast<unsigned char>(c))) {
+            case 'j': query.groupBy.push_back(StatsGroup::PLAYER); break;
+            case 'p': query.groupBy.push_back(StatsGroup::POSITION); break;
+            case 's': query.groupBy.push_back(StatsGroup::STACK_DEPTH); break;
+            case 't': query.groupBy.push_back(StatsGroup::BOARD_TEXTURE); break;
+            default: break;
+        }
+    }
+    std::cout << "Joueur (- = tous): ";
+    std::cin >> query.filter.player;
+    if (query.filter.player == "-") query.filter.player.clear();
+    std::cout << "Mains minimum par ligne: ";
+    std::cin >> query.minHands;
+    std::cout << "Nombre maximum de lignes (0 = toutes): ";
+    std::cin >> query.maxRows;
+    std::cout << "Fichier CSV (- = aucun): ";
+    std::cin >> csvPath;
+
+    try {
+        StatsTable table = PlayerStatsEngine(query).run(logPath);
+        std::cout << "\n" << table.toString();
+
+        if (csvPath != "-") {
+            table.writeCsv(csvPath);
+            std::cout << "Tableau ecrit dans " << csvPath << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << "Erreur: " << e.what() << std::endl;
+    }
+}
+
 /**
  * @brief Programme principal
  */
-int main() {
+int main(int argc, char* argv[]) {
+    // --stats: compteurs du solveur affichés après chaque action
+    // --trace fichier.json: chronologie des calculs (chrome://tracing, Perfetto) écrite en quittant
+    bool showStats = false;
+    std::string tracePath;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--stats") == 0) {
+            showStats = true;
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else {
+            std::cerr << "Option inconnue: " << argv[i] << " (options: --stats, --trace fichier.json)" << std::endl;
+            return 1;
+        }
+    }
+    Instrumentation::setEnabled(showStats);
+    Trace::setEnabled(!tracePath.empty());
+    
     std::cout << "========================================" << std::endl;
     std::cout << "  BIENVENUE DANS LE POKER SOLVER" << std::endl;
     std::cout << "========================================" << std::endl;
@@ -311,6 +617,38 @@ int main() {
                 break;
             
             case 5:
+                flopReportMode();
+                break;
+            
+            case 6:
+                pushFoldMode();
+                break;
+            
+            case 7:
+                matchMode();
+                break;
+            
+            case 8:
+                importMode();
+                break;
+            
+            case 9:
+                allInLuckMode();
+                break;
+            
+            case 10:
+                playerStatsMode();
+                break;
+            
+            case 11:
+                if (!tracePath.empty()) {
+                    try {
+                        size_t spans = Trace::writeChromeJson(tracePath);
+                        std::cout << "\nTrace ecrite: " << spans << " intervalles dans " << tracePath << std::endl;
+                    } catch (const std::exception& e) {
+                        std::cout << "\nErreur: " << e.what() << std::endl;
+                    }
+                }
                 std::cout << "\nMerci d'avoir utilise le Poker Solver!" << std::endl;
                 running = false;
                 break;
@@ -319,6 +657,11 @@ int main() {
                 std::cout << "\nChoix invalide. Reessayez." << std::endl;
         }
         
+        if (showStats && running) {
+            std::cout << "\n" << Instrumentation::stats().toString();
+            Instrumentation::reset();
+        }
+        
         if (running) {
             std::cout << "\nAppuyez sur Entree pour continuer...";
             std::cin.ignore();